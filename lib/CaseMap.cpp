@@ -0,0 +1,112 @@
+#include <cstring>
+
+#include "CaseMap.h"
+#include "Simd.h"
+#include "Transcode.h"
+
+#ifdef UTF8_SSE2
+  #include <immintrin.h>
+#endif
+
+using namespace utf8;
+
+typedef const unsigned char* bytes_t;
+
+static inline const casemap::Mapping& Find(const casemap::Table& table, uint32_t cp)
+{
+  uint16_t i = cp < table.Limit ? table.Blocks[table.Index[cp >> 6]][cp & 63] : 0;
+  return table.Mappings[i];
+}
+
+// Maps the ASCII prefix of [s, end) to p, at most limit bytes, and returns
+// its size. ASCII letters are the only ASCII code points with case mappings
+static size_t MapAscii(const casemap::Table& table, bytes_t s, bytes_t end, size_t limit, char* p)
+{
+  // 'A' or 'a', letters differ by 0x20
+  unsigned char first = &table == &casemap::Lower ? 'A' : 'a';
+  bytes_t stop = end - s > ptrdiff_t(limit) ? s + limit : end;
+  bytes_t i = s;
+
+#ifdef UTF8_SSE2
+  for (; stop - i >= 16; i += 16, p += 16)
+  {
+    __m128i in = _mm_loadu_si128((const __m128i*)i);
+    if (_mm_movemask_epi8(in))
+      break;
+
+    // in - first < 26 as a signed compare after biasing to -128
+    __m128i rel = _mm_sub_epi8(in, _mm_set1_epi8(char(first + 128)));
+    __m128i letter = _mm_cmplt_epi8(rel, _mm_set1_epi8(char(26 - 128)));
+    _mm_storeu_si128((__m128i*)p, _mm_xor_si128(in, _mm_and_si128(letter, _mm_set1_epi8(0x20))));
+  }
+#endif
+
+  for (; i < stop && *i < 0x80; ++i)
+    *p++ = char(unsigned(*i - first) < 26 ? *i ^ 0x20 : *i);
+
+  return size_t(i - s);
+}
+
+size_t casemap::Map(const Table& table, const char* ptr, size_t size, std::string& out)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+  size_t len = 0;
+
+  // Most mappings keep the size, grow when less than Slack bytes are left
+  const size_t Slack = 64;
+  size_t used = out.size();
+  out.resize(used + size + Slack);
+
+  while (s < end)
+  {
+    size_t room = out.size() - used;
+    if (room < Slack)
+    {
+      out.resize(out.size() + size_t(end - s) + Slack);
+      room = out.size() - used;
+    }
+
+    char* p = &out[used];
+
+    if (*s < 0x80)
+    {
+      size_t n = MapAscii(table, s, end, room, p);
+      s += n;
+      used += n;
+      len += n;
+      continue;
+    }
+
+    // Input is well-formed, so the lead byte gives the size
+    size_t n = *s >= 0xf0 ? 4 : *s >= 0xe0 ? 3 : 2;
+    uint32_t cp = *s & (0x7f >> n);
+    for (size_t i = 1; i < n; ++i)
+      cp = (cp << 6) | (s[i] & 0x3f);
+
+    const Mapping& m = Find(table, cp);
+    if (m.Size)
+    {
+      memcpy(p, table.Expansions + m.Offset, m.Size);
+      used += m.Size;
+      len += m.Length;
+    }
+    else
+    {
+      if (m.Delta)
+        used += size_t((char*)transcode::EncodeUtf8(uint32_t(int32_t(cp) + m.Delta), (unsigned char*)p) - p);
+      else
+      {
+        memcpy(p, s, n);
+        used += n;
+      }
+
+      ++len;
+    }
+
+    s += n;
+  }
+
+  out.resize(used);
+  return len;
+}
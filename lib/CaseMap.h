@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Built-in Unicode case mapping used on Linux, where neither ICU nor
+// CoreFoundation is available. Tables are generated by
+// tools/gen_case_tables.py into CaseTables.cpp
+
+namespace utf8
+{
+  namespace casemap
+  {
+    // Code point cp maps to cp + Delta when Size is 0 and to Length
+    // characters (Size bytes) at Table::Expansions + Offset otherwise
+    struct Mapping
+    {
+      int32_t Delta;
+      uint16_t Offset;
+      uint8_t Size;
+      uint8_t Length;
+    };
+
+    // Two stage lookup: Index selects a block of 64 mapping indexes, index 0
+    // leaves the code point unchanged. Code points >= Limit are unchanged
+    struct Table
+    {
+      uint32_t Limit;
+      const uint8_t* Index;
+      const uint16_t (*Blocks)[64];
+      const Mapping* Mappings;
+      const char* Expansions;
+    };
+
+    extern const Table Lower;
+    extern const Table Upper;
+
+    // Appends the mapping of well-formed UTF-8 [ptr, ptr + size) to out and
+    // returns the number of characters appended
+    size_t Map(const Table& table, const char* ptr, size_t size, std::string& out);
+  }
+}
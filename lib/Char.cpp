@@ -1,75 +1,117 @@
 #include <utf8/Char.h>
-#include <utf8/Convert.h>
+
+#include "Transcode.h"
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
 
 using namespace utf8;
 
-Char::Char()
-{
-}
+#ifndef _WIN32
+// WINDOWS-1251 bytes 0x80..0xFF, the ANSI code page used by the converters
+// on Posix systems. 0 marks the undefined byte 0x98
+static const uint16_t Cp1251[128] =
+{
+  0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021,
+  0x20AC, 0x2030, 0x0409, 0x2039, 0x040A, 0x040C, 0x040B, 0x040F,
+  0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x2122, 0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F,
+  0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6, 0x00A7,
+  0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407,
+  0x00B0, 0x00B1, 0x0406, 0x0456, 0x0491, 0x00B5, 0x00B6, 0x00B7,
+  0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,
+  0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+  0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+  0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+  0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+  0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+  0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,
+  0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+  0x0448, 0x0449, 0x044A, 0x044B, 0x044C, 0x044D, 0x044E, 0x044F
+};
+#endif
 
-Char::Char(const Char& ch)
- : std::vector<char>(ch)
+Char::Char()
+  : Bytes()
+  , Count(0)
 {
 }
 
 Char::Char(char ch)
+  : Bytes()
+  , Count(0)
 {
-  char str[2]{};
-  str[0] = ch;
-  str[1] = '\0';
+  unsigned char c = (unsigned char)ch;
+  if (c < 0x80)
+  {
+    Encode(c);
+    return;
+  }
 
-  AppendString(utf8::AnsiToUtf8(str));
+#ifdef _WIN32
+  wchar_t w = 0;
+  if (MultiByteToWideChar(CP_ACP, 0, &ch, 1, &w, 1) == 1)
+    Encode(w);
+#else
+  Encode(Cp1251[c - 0x80]);
+#endif
 }
 
 Char::Char(wchar_t ch)
+  : Bytes()
+  , Count(0)
 {
-  wchar_t str[2]{};
-  str[0] = ch;
-  str[1] = '\0';
-
 #ifdef _WIN32
-  std::string s = utf8::Utf16ToUtf8((const w16_type*)str);
+  Encode(char16_t(ch));
 #else
-  std::string s = utf8::Utf32ToUtf8((const w32_type*)str);
+  Encode(uint32_t(ch));
 #endif
-
-  AppendString(s);
 }
 
 Char::Char(char16_t ch)
+  : Bytes()
+  , Count(0)
 {
-  char16_t str[2]{};
-  str[0] = ch;
-  str[1] = '\0';
-
-  AppendString(utf8::Utf16ToUtf8((const w16_type*)str));
+  // A lone surrogate is not a character
+  if (ch < 0xD800 || ch > 0xDFFF)
+    Encode(ch);
 }
 
 Char::Char(char32_t ch)
+  : Bytes()
+  , Count(0)
 {
-  char32_t str[2]{};
-  str[0] = ch;
-  str[1] = '\0';
+  Encode(ch);
+}
 
-  AppendString(utf8::Utf32ToUtf8((const w32_type*)str));
+void Char::Encode(uint32_t cp)
+{
+  // Code point 0 terminated the strings the converters used to build,
+  // invalid code points produced no output. Both give an empty Char
+  if (cp == 0 || (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+    return;
+
+  Count = (unsigned char)((char*)transcode::EncodeUtf8(cp, (unsigned char*)Bytes) - Bytes);
 }
 
 std::string Char::Str() const
 {
-  const std::vector<char>& arr = *this;
-  return std::string(&arr[0], size());
+  return std::string(Bytes, Count);
 }
 
-void Char::AppendString(const std::string& str)
+uint64_t Char::Key() const
 {
-  for (auto ch : str)
-    push_back(ch);
+  uint64_t key = 0;
+  for (size_t i = 0; i < sizeof(Bytes); ++i)
+    key = (key << 8) | (i < Count ? (unsigned char)Bytes[i] : 0);
+
+  return (key << 8) | Count;
 }
 
 bool Char::operator==(const Char& ch) const
 {
-  const std::vector<char>& arr = *this;
-  return arr == ch;
+  return Key() == ch.Key();
 }
 
 bool Char::operator==(char ch) const
@@ -115,4 +157,9 @@ bool Char::operator!=(char16_t ch) const
 bool Char::operator!=(char32_t ch) const
 {
   return !operator==(ch);
+}
+
+bool Char::operator<(const Char& ch) const
+{
+  return Key() < ch.Key();
 }
\ No newline at end of file
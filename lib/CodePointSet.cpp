@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstring>
+
+#include <utf8/CodePointSet.h>
+#include <utf8/String.h>
+
+using namespace utf8;
+
+static char32_t Decode(const char* p, size_t n)
+{
+  const unsigned char* s = (const unsigned char*)p;
+  switch (n)
+  {
+  case 1:
+    return s[0];
+  case 2:
+    return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+  case 3:
+    return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+  case 4:
+    return ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+  }
+
+  return char32_t(-1);
+}
+
+ByteSet::ByteSet(const uint64_t bits[2])
+  : Bits{ bits[0], bits[1] }
+  , Nibbles()
+  , Bytes()
+  , Count(0)
+{
+  for (unsigned c = 0; c < 128; ++c)
+  {
+    if (((Bits[c >> 6] >> (c & 63)) & 1) == 0)
+      continue;
+
+    Nibbles[c & 15] |= uint8_t(1 << (c >> 4));
+    if (Count < sizeof(Bytes))
+      Bytes[Count] = char(c);
+    Count++;
+  }
+}
+
+CodePointSet::CodePointSet()
+  : Ascii()
+  , TwoByte()
+  , Ranges()
+{
+}
+
+CodePointSet::CodePointSet(const CharSet& chars)
+  : CodePointSet()
+{
+  for (auto& ch : chars)
+    Insert(ch);
+}
+
+CodePointSet::CodePointSet(const char* utf8)
+  : CodePointSet()
+{
+  for (;;)
+  {
+    size_t n = String::CharSize(utf8);
+    if (!n)
+      break;
+
+    Insert(Decode(utf8, n));
+    utf8 += n;
+  }
+}
+
+void CodePointSet::Insert(char32_t cp)
+{
+  Insert(cp, cp);
+}
+
+void CodePointSet::Insert(char32_t first, char32_t last)
+{
+  // Nothing lies above U+10FFFF, and last + 1 must not wrap below
+  last = std::min<char32_t>(last, 0x10FFFF);
+  if (first > last)
+    return;
+
+  for (; first <= last && first < 0x800; ++first)
+  {
+    if (first < 0x80)
+      Ascii[first >> 6] |= uint64_t(1) << (first & 63);
+    else
+      TwoByte[(first - 0x80) >> 6] |= uint64_t(1) << ((first - 0x80) & 63);
+  }
+
+  if (first > last)
+    return;
+
+  // Merge with every range that overlaps or touches [first, last]
+  auto it = std::lower_bound(
+    Ranges.begin()
+    , Ranges.end()
+    , first
+    , [](const std::pair<char32_t, char32_t>& r, char32_t cp) { return r.second + 1 < cp; }
+  );
+
+  auto end = it;
+  while (end != Ranges.end() && end->first <= last + 1)
+  {
+    first = std::min(first, end->first);
+    last = std::max(last, end->second);
+    ++end;
+  }
+
+  it = Ranges.erase(it, end);
+  Ranges.insert(it, std::make_pair(first, last));
+}
+
+void CodePointSet::Insert(const Char& ch)
+{
+  if (!ch.empty())
+    Insert(Decode(ch.data(), ch.size()));
+}
+
+bool CodePointSet::Empty() const
+{
+  return !Ascii[0] && !Ascii[1] && IsAscii();
+}
+
+bool CodePointSet::IsAscii() const
+{
+  for (auto bits : TwoByte)
+    if (bits)
+      return false;
+
+  return Ranges.empty();
+}
+
+bool CodePointSet::Contains(char32_t cp) const
+{
+  if (cp < 0x80)
+    return (Ascii[cp >> 6] >> (cp & 63)) & 1;
+
+  if (cp < 0x800)
+    return (TwoByte[(cp - 0x80) >> 6] >> ((cp - 0x80) & 63)) & 1;
+
+  auto it = std::upper_bound(
+    Ranges.begin()
+    , Ranges.end()
+    , cp
+    , [](char32_t cp, const std::pair<char32_t, char32_t>& r) { return cp < r.first; }
+  );
+
+  return it != Ranges.begin() && cp <= (it - 1)->second;
+}
+
+bool CodePointSet::Contains(const Char& ch) const
+{
+  return !ch.empty() && Contains(ch.data(), ch.size());
+}
+
+bool CodePointSet::InRanges(const char* p, size_t n) const
+{
+  return Contains(Decode(p, n));
+}
@@ -1,10 +1,15 @@
+#include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <cstring>
 #include <vector>
 
 #include <utf8/Convert.h>
 #include <utf8/StringTemplate.h>
 
+#include "CaseMap.h"
+#include "Transcode.h"
+
 #ifdef _WIN32
   #include <windows.h>
 #else 
@@ -13,15 +18,7 @@
   #endif
 
   #include <iconv.h>
-#endif
-
-#define UNI_SUR_HIGH_START  (w32_type)0xD800
-#define UNI_SUR_HIGH_END    (w32_type)0xDBFF
-#define UNI_SUR_LOW_START   (w32_type)0xDC00
-#define UNI_SUR_LOW_END     (w32_type)0xDFFF
-
-#ifndef UNI_MAX_LEGAL_UTF32
-#define UNI_MAX_LEGAL_UTF32 (w32_type)0x0010FFFF
+  #include <pthread.h>
 #endif
 
 #pragma warning(disable : 5051)
@@ -43,40 +40,149 @@ using namespace utf8;
 w16_type* w16_strncpyz(w16_type* dest, const w16_type* src, size_t num) { return xstrncpyz(dest, src, num); }
 
 #ifndef _WIN32
+// Bumped in the child after fork(). Descriptors cached before the fork are
+// not reused by the child process
+static std::atomic<unsigned> ForkGeneration(0);
+
+static void OnForkChild()
+{
+  ForkGeneration++;
+}
+
+// iconv_open loads gconv modules and takes global locks, so opened
+// descriptors are kept per thread and per (from, to) pair. They are
+// closed when the thread exits
+class IconvCache
+{
+  struct Entry
+  {
+    std::string From;
+    std::string To;
+    iconv_t Handle;
+  };
+
+  std::vector<Entry> Entries;
+  unsigned Generation;
+
+public:
+  IconvCache()
+    : Generation(ForkGeneration)
+  {
+    static int registered = pthread_atfork(nullptr, nullptr, OnForkChild);
+    (void)registered;
+  }
+
+  ~IconvCache()
+  {
+    Clear();
+  }
+
+  iconv_t Open(const char* to, const char* from)
+  {
+    if (Generation != ForkGeneration)
+    {
+      Clear();
+      Generation = ForkGeneration;
+    }
+
+    for (auto& e : Entries)
+    {
+      if (e.From == from && e.To == to)
+      {
+        // Reset conversion state left by the previous call
+        iconv(e.Handle, nullptr, nullptr, nullptr, nullptr);
+        return e.Handle;
+      }
+    }
+
+    iconv_t h = iconv_open(to, from);
+    if (h != (iconv_t)-1)
+      Entries.push_back(Entry{from, to, h});
+
+    return h;
+  }
+
+  void Clear()
+  {
+    for (auto& e : Entries)
+      iconv_close(e.Handle);
+
+    Entries.clear();
+  }
+};
+
+static thread_local IconvCache Iconv;
+
+// Converts cbin bytes at ptr and appends the result to str. iconv writes
+// into a fixed size stack chunk which is flushed to str every time it fills
+// up (E2BIG), so memory use does not depend on the input size besides the
+// result itself. On failure str is restored and false is returned
 template<typename tstring, typename tchar>
-tstring posixEncodeString(
-  const char* ptr
+bool posixAppendString(
+  tstring& str
+  , const char* ptr
   , size_t cbin
   , const char* from
   , const char* to
 )
 {
   if (cbin == 0)
-    return tstring();
+    return true;
 
-  iconv_t h = iconv_open(to, from);
+  iconv_t h = Iconv.Open(to, from);
   if (h == (iconv_t)-1)
   {
     assert(!"iconv_open failed");
-    return tstring();
+    return false;
   }
 
+  size_t size0 = str.size();
   char* in = (char*)ptr;
-  size_t cbout = 4 * cbin; // Should be enough in all cases
-
-  char* buffer = (char*)alloca(cbout);
-  memset(buffer, 0, cbout);
 
-  char* out = buffer;
-  size_t nc = iconv(h, &in, &cbin, &out, &cbout);
-  if (nc == -1)
+  tchar chunk[2048 / sizeof(tchar)];
+  for (bool flush = false;;)
   {
-    assert(!"Conversion failed!!");
-    *buffer = '\0';
+    char* out = (char*)chunk;
+    size_t cbout = sizeof(chunk);
+
+    // The final call with no input writes out any pending shift state
+    size_t nc = flush
+      ? iconv(h, nullptr, nullptr, &out, &cbout)
+      : iconv(h, &in, &cbin, &out, &cbout);
+
+    str.append(chunk, (tchar*)out - chunk);
+
+    if (nc != (size_t)-1)
+    {
+      if (flush)
+        return true;
+
+      flush = true;
+      continue;
+    }
+
+    if (errno != E2BIG)
+    {
+      assert(!"Conversion failed!!");
+      str.resize(size0);
+      return false;
+    }
   }
+}
+
+template<typename tstring, typename tchar>
+tstring posixEncodeString(
+  const char* ptr
+  , size_t cbin
+  , const char* from
+  , const char* to
+)
+{
+  tstring str;
+  str.reserve(cbin);
 
-  iconv_close(h);
-  return tstring((tchar*)buffer);
+  posixAppendString<tstring, tchar>(str, ptr, cbin, from, to);
+  return str;
 }
 #endif // #ifndef _WIN32
 
@@ -91,7 +197,11 @@ std::wstring utf8::Utf8ToWstring(const char* ptr)
 
 std::string utf8::WstringToUtf8(const std::wstring &str)
 {
+#ifdef _WIN32
   return utf8::WstringToUtf8(str.c_str());
+#else
+  return Utf32ToUtf8(str.c_str(), str.size());
+#endif
 }
 
 std::string utf8::WstringToUtf8(const wchar_t* ptr)
@@ -343,13 +453,26 @@ w16string utf8::Utf8ToUtf16(const char* ptr)
     return w16string();
 
   return w16string(&buffer[0]);
-#else
+#elif defined(UTF8_USE_ICONV)
   return posixEncodeString<w16string, w16_type>(
     ptr
     , strlen(ptr)
     , "UTF-8"
     , "UTF-16LE"
   );
+#else
+  size_t size = strlen(ptr);
+  w16string str(size, 0);
+
+  size_t n = transcode::Utf8ToUtf16(ptr, size, &str[0]);
+  if (n == transcode::npos)
+  {
+    assert(!"Conversion failed!!");
+    return w16string();
+  }
+
+  str.resize(n);
+  return str;
 #endif  
 }
 
@@ -375,6 +498,20 @@ inline w32_type surrogate_to_utf32(w16_type high, w16_type low)
 
 w32string utf8::Utf8ToUtf32(const char* ptr)
 {
+#ifndef UTF8_USE_ICONV
+  size_t size = strlen(ptr);
+  w32string w32(size, 0);
+
+  size_t n = transcode::Utf8ToUtf32(ptr, size, &w32[0]);
+  if (n == transcode::npos)
+  {
+    assert(!"Invalid utf-8 string");
+    return w32string();
+  }
+
+  w32.resize(n);
+  return w32;
+#else
   w16string w16 = Utf8ToUtf16(ptr);
   size_t size = w16.size();
 
@@ -407,62 +544,25 @@ w32string utf8::Utf8ToUtf32(const char* ptr)
     return w32string();
   }
   return w32;
+#endif
 }
 
-/*
- * Once the bits are split out into bytes of UTF-8, this is a mask OR-ed
- * into the first byte, depending on how many bytes follow.  There are
- * as many entries in this table as there are UTF-8 sequence types.
- * (I.e., one byte sequence, two byte... etc.). Remember that sequencs
- * for *legal* UTF-8 will be 4 or fewer bytes total.
- */
-static const w32_type FirstByteMark[7] = 
-{ 
-  0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC 
-};
+std::string utf8::Utf32ToUtf8(const w32_type* ptr)
+{
+  return Utf32ToUtf8(ptr, w32_strlen(ptr));
+}
 
-std::string utf8::Utf32ToUtf8(const w32_type* source)
+std::string utf8::Utf32ToUtf8(const w32_type* ptr, size_t n)
 {
-  std::string utf8;
+  // UTF-16 surrogate values and values above U+10FFFF are illegal
+  size_t size = transcode::Utf32ToUtf8Size(ptr, n);
+  if (size == transcode::npos)
+    return std::string();
 
-  while (*source) 
-  {
-    // UTF-16 surrogate values are illegal in UTF-32
-    w32_type ch = *source++;
-    if (ch >= UNI_SUR_HIGH_START && ch <= UNI_SUR_LOW_END) 
-      return std::string();
-
-    // Figure out how many bytes the result will require. Turn any
-    // illegally large UTF32 things (> Plane 17) into replacement chars.
-    int cb = 0;
-    if (ch < (w32_type)0x80)
-      cb = 1;
-    else if (ch < (w32_type)0x800) 
-      cb = 2;
-    else if (ch < (w32_type)0x10000) 
-      cb = 3;
-    else if (ch <= UNI_MAX_LEGAL_UTF32) 
-      cb = 4;
-    else 
-      return std::string();
-
-    const w32_type byteMask = 0xBF;
-    const w32_type byteMark = 0x80;
-
-    char arr[4]{};
-    char* p = arr + cb - 1;
-
-    switch (cb) 
-    {
-      case 4: *p-- = (char)((ch | byteMark) & byteMask); ch >>= 6; [[fallthrough]];
-      case 3: *p-- = (char)((ch | byteMark) & byteMask); ch >>= 6; [[fallthrough]];
-      case 2: *p-- = (char)((ch | byteMark) & byteMask); ch >>= 6; [[fallthrough]];
-      case 1: *p = (char)(ch | FirstByteMark[cb]);
-    }
+  std::string utf8(size, '\0');
+  if (size)
+    transcode::Utf32ToUtf8(ptr, n, &utf8[0]);
 
-    for (int i = 0; i < cb; ++i)
-      utf8.push_back(arr[i]);
-  }
   return utf8;
 }
 
@@ -530,4 +630,24 @@ std::string utf8::Utf8ToUpper(const char* ptr)
 
   return std::string();
 }
+#elif !defined(_WIN32)
+std::string utf8::Utf8ToLower(const char* ptr)
+{
+  std::string result;
+  size_t size = strlen(ptr);
+
+  result.reserve(size);
+  casemap::Map(casemap::Lower, ptr, size, result);
+  return result;
+}
+
+std::string utf8::Utf8ToUpper(const char* ptr)
+{
+  std::string result;
+  size_t size = strlen(ptr);
+
+  result.reserve(size);
+  casemap::Map(casemap::Upper, ptr, size, result);
+  return result;
+}
 #endif  
@@ -0,0 +1,113 @@
+#include <algorithm>
+
+#include <utf8/EditBatch.h>
+#include <utf8/String.h>
+
+using namespace utf8;
+
+EditBatch& EditBatch::Remove(size_t pos, size_t count)
+{
+  return Replace(pos, count, StringView());
+}
+
+EditBatch& EditBatch::Insert(size_t pos, const StringView& text)
+{
+  return Replace(pos, 0, text);
+}
+
+EditBatch& EditBatch::Replace(size_t pos, size_t count, const StringView& text)
+{
+  Edit edit;
+  edit.Pos = pos;
+  edit.Count = count;
+  edit.Text = text.Str();
+  edit.Len = text.Length();
+
+  Edits.push_back(std::move(edit));
+  return *this;
+}
+
+size_t EditBatch::Size() const
+{
+  return Edits.size();
+}
+
+bool EditBatch::Empty() const
+{
+  return Edits.empty();
+}
+
+void EditBatch::Clear()
+{
+  Edits.clear();
+}
+
+bool EditBatch::Apply(String& str) const
+{
+  if (Edits.empty())
+    return true;
+
+  std::vector<const Edit*> order;
+  order.reserve(Edits.size());
+  for (auto& edit : Edits)
+    order.push_back(&edit);
+
+  // Inserts go before a removal at the same position
+  std::stable_sort(
+    order.begin()
+    , order.end()
+    , [](const Edit* a, const Edit* b)
+      {
+        return a->Pos != b->Pos ? a->Pos < b->Pos : a->Count == 0 && b->Count != 0;
+      }
+  );
+
+  // Byte ranges of the removed characters, found in one forward scan
+  std::vector<std::pair<size_t, size_t>> ranges(order.size());
+
+  const char* p0 = str.c_str();
+  const char* p = p0;
+  size_t pos = 0;               // Character index of p
+  size_t end = 0;               // End of the last removed range
+  size_t length = str.Length();
+  size_t size = str.Size();
+  size_t len = length;
+
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    const Edit& edit = *order[i];
+    if (edit.Pos < end || edit.Pos > length || edit.Count > length - edit.Pos)
+      return false;
+
+    for (; pos < edit.Pos; ++pos)
+      p += String::CharSize(p);
+    ranges[i].first = p - p0;
+
+    for (; pos < edit.Pos + edit.Count; ++pos)
+      p += String::CharSize(p);
+    ranges[i].second = p - p0;
+
+    end = edit.Pos + edit.Count;
+    size += edit.Text.size() - (ranges[i].second - ranges[i].first);
+    len += edit.Len - edit.Count;
+  }
+
+  std::string data;
+  data.reserve(size);
+
+  size_t copied = 0;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    data.append(p0 + copied, ranges[i].first - copied);
+    data.append(order[i]->Text);
+    copied = ranges[i].second;
+  }
+  data.append(p0 + copied, str.Size() - copied);
+
+  str.Data.swap(data);
+  str.Len = len;
+  str.DropIndex();
+
+  ASSERT_VALID_UTF8(str.Data);
+  return true;
+}
@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <cassert>
+
+#include <utf8/Rope.h>
+#include <utf8/String.h>
+
+#include "Simd.h"
+
+using namespace utf8;
+
+struct Rope::Node
+{
+  std::string Chunk;
+  size_t ChunkLen;              // Characters in Chunk
+  size_t Bytes;                 // Totals of the subtree
+  size_t Chars;
+  uint32_t Priority;
+
+  NodePtr Left;
+  NodePtr Right;
+};
+
+const size_t Rope::MaxChunk;
+
+// Byte offset of the character n characters after byte offset of chunk
+static size_t Advance(const std::string& chunk, size_t offset, size_t n)
+{
+  const char* p = chunk.c_str();
+  return simd::SkipChars(p + offset, p + chunk.size(), n) - p;
+}
+
+Rope::Rope()
+  : Seed(0x9E3779B9)
+{
+}
+
+Rope::Rope(const StringView& text)
+  : Seed(0x9E3779B9)
+{
+  Root = Build(text.data(), text.Size());
+}
+
+Rope::Rope(const Rope& rope)
+  : Root(Clone(rope.Root.get()))
+  , Seed(rope.Seed)
+{
+}
+
+Rope::Rope(Rope&& rope) noexcept
+  : Root(std::move(rope.Root))
+  , Seed(rope.Seed)
+{
+}
+
+Rope::~Rope()
+{
+}
+
+Rope& Rope::operator=(const Rope& rope)
+{
+  if (this != &rope)
+  {
+    Root = Clone(rope.Root.get());
+    Seed = rope.Seed;
+  }
+
+  return *this;
+}
+
+Rope& Rope::operator=(Rope&& rope) noexcept
+{
+  Root = std::move(rope.Root);
+  Seed = rope.Seed;
+  return *this;
+}
+
+bool Rope::Empty() const
+{
+  return !Root;
+}
+
+size_t Rope::Length() const
+{
+  return Root ? Root->Chars : 0;
+}
+
+size_t Rope::Size() const
+{
+  return Root ? Root->Bytes : 0;
+}
+
+Char Rope::CharAt(size_t charIndex) const
+{
+  const Node* node = Root.get();
+  while (node)
+  {
+    size_t left = node->Left ? node->Left->Chars : 0;
+    if (charIndex < left)
+    {
+      node = node->Left.get();
+      continue;
+    }
+
+    charIndex -= left;
+    if (charIndex >= node->ChunkLen)
+    {
+      charIndex -= node->ChunkLen;
+      node = node->Right.get();
+      continue;
+    }
+
+    const char* p = node->Chunk.c_str() + Advance(node->Chunk, 0, charIndex);
+
+    Char ch;
+    for (size_t size = String::CharSize(p); size; --size)
+      ch.push_back(*p++);
+
+    return ch;
+  }
+
+  return Char();
+}
+
+String Rope::Substr(size_t pos, size_t count) const
+{
+  size_t len = Length();
+  if (pos >= len)
+    return String();
+
+  String str;
+  str.Len = std::min(count, len - pos);
+  AppendRange(Root.get(), pos, str.Len, str.Data);
+
+  ASSERT_VALID_UTF8(str.Data);
+  return str;
+}
+
+String Rope::ToString() const
+{
+  String str;
+  if (Root)
+  {
+    str.Data.reserve(Root->Bytes);
+    str.Len = Root->Chars;
+    AppendRange(Root.get(), 0, Root->Chars, str.Data);
+  }
+
+  ASSERT_VALID_UTF8(str.Data);
+  return str;
+}
+
+bool Rope::InsertAt(size_t charIndex, const StringView& text)
+{
+  size_t len = Length();
+  if (charIndex == std::string::npos)
+    charIndex = len;
+
+  if (charIndex > len)
+    return false;
+
+  if (text.Empty())
+    return true;
+
+  // Short text goes into an existing chunk when it fits
+  if (InsertInChunk(Root.get(), charIndex, text.data(), text.Size(), text.Length()))
+    return true;
+
+  NodePtr left;
+  NodePtr right;
+  Split(std::move(Root), charIndex, left, right);
+
+  Root = Merge(Merge(std::move(left), Build(text.data(), text.Size())), std::move(right));
+  return true;
+}
+
+bool Rope::RemoveAt(size_t charIndex, size_t count)
+{
+  size_t len = Length();
+  if (charIndex >= len)
+    return false;
+
+  count = std::min(count, len - charIndex);
+
+  // Range inside one chunk is erased in place
+  if (RemoveInChunk(Root.get(), charIndex, count) != 0)
+    return true;
+
+  NodePtr left;
+  NodePtr middle;
+  NodePtr right;
+  Split(std::move(Root), charIndex, left, right);
+  Split(std::move(right), count, middle, right);
+
+  Root = Merge(std::move(left), std::move(right));
+  return true;
+}
+
+void Rope::Append(const StringView& text)
+{
+  InsertAt(Length(), text);
+}
+
+void Rope::Clear()
+{
+  Root.reset();
+}
+
+Rope::NodePtr Rope::Clone(const Node* node)
+{
+  if (!node)
+    return nullptr;
+
+  NodePtr copy(new Node);
+  copy->Chunk = node->Chunk;
+  copy->ChunkLen = node->ChunkLen;
+  copy->Bytes = node->Bytes;
+  copy->Chars = node->Chars;
+  copy->Priority = node->Priority;
+  copy->Left = Clone(node->Left.get());
+  copy->Right = Clone(node->Right.get());
+  return copy;
+}
+
+Rope::NodePtr Rope::NewNode(const char* ptr, size_t size, size_t len)
+{
+  // xorshift32
+  Seed ^= Seed << 13;
+  Seed ^= Seed >> 17;
+  Seed ^= Seed << 5;
+
+  NodePtr node(new Node);
+  node->Chunk.assign(ptr, size);
+  node->ChunkLen = len;
+  node->Priority = Seed;
+
+  Update(node.get());
+  return node;
+}
+
+Rope::NodePtr Rope::Build(const char* ptr, size_t size)
+{
+  NodePtr root;
+  while (size)
+  {
+    // Chunks end on character boundaries
+    size_t n = size;
+    if (n > MaxChunk)
+    {
+      n = MaxChunk;
+      while (n && ((unsigned char)ptr[n] & 0xC0) == 0x80)
+        --n;
+    }
+
+    root = Merge(std::move(root), NewNode(ptr, n, Utf8Length(ptr, n)));
+    ptr += n;
+    size -= n;
+  }
+
+  return root;
+}
+
+void Rope::Update(Node* node)
+{
+  node->Bytes = node->Chunk.size();
+  node->Chars = node->ChunkLen;
+
+  if (node->Left)
+  {
+    node->Bytes += node->Left->Bytes;
+    node->Chars += node->Left->Chars;
+  }
+
+  if (node->Right)
+  {
+    node->Bytes += node->Right->Bytes;
+    node->Chars += node->Right->Chars;
+  }
+}
+
+Rope::NodePtr Rope::Merge(NodePtr left, NodePtr right)
+{
+  if (!left)
+    return right;
+  if (!right)
+    return left;
+
+  if (left->Priority > right->Priority)
+  {
+    left->Right = Merge(std::move(left->Right), std::move(right));
+    Update(left.get());
+    return left;
+  }
+
+  right->Left = Merge(std::move(left), std::move(right->Left));
+  Update(right.get());
+  return right;
+}
+
+void Rope::Split(NodePtr node, size_t charIndex, NodePtr& left, NodePtr& right)
+{
+  if (!node)
+  {
+    left.reset();
+    right.reset();
+    return;
+  }
+
+  size_t leftChars = node->Left ? node->Left->Chars : 0;
+  if (charIndex <= leftChars)
+  {
+    Split(std::move(node->Left), charIndex, left, node->Left);
+    Update(node.get());
+    right = std::move(node);
+  }
+  else if (charIndex >= leftChars + node->ChunkLen)
+  {
+    Split(std::move(node->Right), charIndex - leftChars - node->ChunkLen, node->Right, right);
+    Update(node.get());
+    left = std::move(node);
+  }
+  else
+  {
+    // Split inside the chunk: the tail becomes a new node
+    size_t n = charIndex - leftChars;
+    size_t offset = Advance(node->Chunk, 0, n);
+
+    NodePtr tail = NewNode(node->Chunk.c_str() + offset, node->Chunk.size() - offset, node->ChunkLen - n);
+    node->Chunk.resize(offset);
+    node->ChunkLen = n;
+
+    right = Merge(std::move(tail), std::move(node->Right));
+    Update(node.get());
+    left = std::move(node);
+  }
+}
+
+bool Rope::InsertInChunk(Node* node, size_t charIndex, const char* ptr, size_t size, size_t len)
+{
+  if (!node)
+    return false;
+
+  size_t leftChars = node->Left ? node->Left->Chars : 0;
+
+  bool inserted;
+  if (charIndex < leftChars)
+    inserted = InsertInChunk(node->Left.get(), charIndex, ptr, size, len);
+  else if (charIndex > leftChars + node->ChunkLen)
+    inserted = InsertInChunk(node->Right.get(), charIndex - leftChars - node->ChunkLen, ptr, size, len);
+  else if (node->Chunk.size() + size <= MaxChunk)
+  {
+    size_t offset = Advance(node->Chunk, 0, charIndex - leftChars);
+    node->Chunk.insert(offset, ptr, size);
+    node->ChunkLen += len;
+    inserted = true;
+  }
+  else
+    inserted = false;
+
+  if (inserted)
+  {
+    node->Bytes += size;
+    node->Chars += len;
+  }
+
+  return inserted;
+}
+
+size_t Rope::RemoveInChunk(Node* node, size_t charIndex, size_t count)
+{
+  size_t leftChars = node->Left ? node->Left->Chars : 0;
+
+  size_t bytes;
+  if (charIndex < leftChars)
+    bytes = RemoveInChunk(node->Left.get(), charIndex, count);
+  else if (charIndex >= leftChars + node->ChunkLen)
+    bytes = RemoveInChunk(node->Right.get(), charIndex - leftChars - node->ChunkLen, count);
+  else
+  {
+    // Keep chunks non-empty
+    size_t pos = charIndex - leftChars;
+    if (pos + count > node->ChunkLen || count == node->ChunkLen)
+      return 0;
+
+    size_t begin = Advance(node->Chunk, 0, pos);
+    bytes = Advance(node->Chunk, begin, count) - begin;
+
+    node->Chunk.erase(begin, bytes);
+    node->ChunkLen -= count;
+  }
+
+  if (bytes)
+  {
+    node->Bytes -= bytes;
+    node->Chars -= count;
+  }
+
+  return bytes;
+}
+
+void Rope::AppendRange(const Node* node, size_t charIndex, size_t count, std::string& out)
+{
+  if (!node || !count)
+    return;
+
+  size_t leftChars = node->Left ? node->Left->Chars : 0;
+  if (charIndex < leftChars)
+  {
+    size_t n = std::min(count, leftChars - charIndex);
+    AppendRange(node->Left.get(), charIndex, n, out);
+    count -= n;
+    charIndex = leftChars;
+  }
+
+  size_t pos = charIndex - leftChars;
+  if (count && pos < node->ChunkLen)
+  {
+    size_t n = std::min(count, node->ChunkLen - pos);
+    size_t begin = Advance(node->Chunk, 0, pos);
+    size_t end = Advance(node->Chunk, begin, n);
+
+    out.append(node->Chunk, begin, end - begin);
+    count -= n;
+    charIndex += n;
+  }
+
+  AppendRange(node->Right.get(), charIndex - leftChars - node->ChunkLen, count, out);
+}
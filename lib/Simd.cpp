@@ -0,0 +1,598 @@
+#include <cstring>
+
+#include "Simd.h"
+
+#ifdef UTF8_SSE2
+  #include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#endif
+
+using namespace utf8;
+
+typedef const unsigned char* bytes_t;
+
+static inline unsigned CountTrailingZeros(uint32_t mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return unsigned(index);
+#else
+  return unsigned(__builtin_ctz(mask));
+#endif
+}
+
+static inline unsigned PopCount(uint64_t v)
+{
+  v = v - ((v >> 1) & 0x5555555555555555ULL);
+  v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+  v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return unsigned((v * 0x0101010101010101ULL) >> 56);
+}
+
+#ifdef UTF8_AVX2
+static bool DetectAvx2()
+{
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuid(regs, 0);
+  if (regs[0] < 7)
+    return false;
+
+  // OSXSAVE and AVX, then check that the OS saves YMM state
+  __cpuid(regs, 1);
+  if ((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0)
+    return false;
+
+  if ((_xgetbv(0) & 6) != 6)
+    return false;
+
+  __cpuidex(regs, 7, 0);
+  return (regs[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+bool simd::HasAvx2()
+{
+#ifdef UTF8_AVX2
+  static const bool avx2 = DetectAvx2();
+  return avx2;
+#else
+  return false;
+#endif
+}
+
+static bytes_t SkipAscii(bytes_t s, bytes_t end)
+{
+#ifdef UTF8_SSE2
+  for (; end - s >= 16; s += 16)
+  {
+    int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)s));
+    if (mask)
+      return s + CountTrailingZeros(uint32_t(mask));
+  }
+#else
+  for (; end - s >= 8; s += 8)
+  {
+    uint64_t word;
+    memcpy(&word, s, sizeof(word));
+    if (word & 0x8080808080808080ULL)
+      break;
+  }
+#endif
+
+  while (s < end && *s < 0x80)
+    s++;
+
+  return s;
+}
+
+size_t simd::AsciiPrefix(const char* ptr, size_t size)
+{
+  bytes_t s = (bytes_t)ptr;
+  return size_t(SkipAscii(s, s + size) - s);
+}
+
+static size_t CountCharsScalar(bytes_t s, bytes_t end)
+{
+  size_t n = 0;
+
+  // 8 bytes at a time: a byte is a continuation byte if bit 7 is set and
+  // bit 6 is clear
+  for (; end - s >= 8; s += 8)
+  {
+    uint64_t word;
+    memcpy(&word, s, sizeof(word));
+
+    uint64_t cont = word & ~(word << 1) & 0x8080808080808080ULL;
+    n += 8 - PopCount(cont);
+  }
+
+  for (; s < end; ++s)
+    n += (*s & 0xc0) != 0x80;
+
+  return n;
+}
+
+#ifdef UTF8_SSE2
+static size_t CountCharsSse2(bytes_t& s, bytes_t end)
+{
+  size_t n = 0;
+  const __m128i limit = _mm_set1_epi8(-65); // 0xBF, last continuation byte
+
+  while (end - s >= 16)
+  {
+    // Per byte counters overflow after 255 blocks
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < 255 && end - s >= 16; ++i, s += 16)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i*)s);
+      acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(v, limit));
+    }
+
+    __m128i sums = _mm_sad_epu8(acc, _mm_setzero_si128());
+    n += size_t(_mm_cvtsi128_si32(sums)) + size_t(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+  }
+  return n;
+}
+#endif
+
+#ifdef UTF8_AVX2
+UTF8_TARGET_AVX2
+static size_t CountCharsAvx2(bytes_t& s, bytes_t end)
+{
+  size_t n = 0;
+  const __m256i limit = _mm256_set1_epi8(-65);
+
+  while (end - s >= 32)
+  {
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < 255 && end - s >= 32; ++i, s += 32)
+    {
+      __m256i v = _mm256_loadu_si256((const __m256i*)s);
+      acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(v, limit));
+    }
+
+    __m256i sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    n += size_t(_mm_cvtsi128_si32(half)) + size_t(_mm_cvtsi128_si32(_mm_srli_si128(half, 8)));
+  }
+  return n;
+}
+#endif
+
+size_t simd::CountChars(const char* ptr, size_t size)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+  size_t n = 0;
+
+#ifdef UTF8_AVX2
+  if (size >= 64 && HasAvx2())
+    n += CountCharsAvx2(s, end);
+#endif
+
+#ifdef UTF8_SSE2
+  n += CountCharsSse2(s, end);
+#endif
+
+  return n + CountCharsScalar(s, end);
+}
+
+const char* simd::SkipChars(const char* ptr, const char* end, size_t n)
+{
+  for (; n && ptr < end; --n)
+  {
+    ptr++;
+    while (ptr < end && ((unsigned char)*ptr & 0xc0) == 0x80)
+      ptr++;
+  }
+  return ptr;
+}
+
+static bytes_t FindByteScalar(bytes_t s, bytes_t end, const ByteSet& set)
+{
+  for (; s < end; ++s)
+  {
+    if (*s < 0x80 && ((set.Bits[*s >> 6] >> (*s & 63)) & 1))
+      break;
+  }
+  return s;
+}
+
+#ifdef UTF8_SSE2
+// One compare per member, used for small sets
+static inline uint32_t MatchSse2(bytes_t s, const __m128i* members, size_t count)
+{
+  __m128i v = _mm_loadu_si128((const __m128i*)s);
+  __m128i eq = _mm_cmpeq_epi8(v, members[0]);
+  for (size_t i = 1; i < count; ++i)
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi8(v, members[i]));
+
+  return uint32_t(_mm_movemask_epi8(eq));
+}
+
+// Returns true with s at the match or false with s at the unscanned tail
+static bool FindByteSse2(bytes_t& s, bytes_t end, const ByteSet& set)
+{
+  __m128i members[sizeof(set.Bytes)];
+  for (size_t i = 0; i < set.Count; ++i)
+    members[i] = _mm_set1_epi8(set.Bytes[i]);
+
+  for (; end - s >= 16; s += 16)
+  {
+    uint32_t mask = MatchSse2(s, members, set.Count);
+    if (mask)
+    {
+      s += CountTrailingZeros(mask);
+      return true;
+    }
+  }
+  return false;
+}
+
+static size_t CountBytesSse2(bytes_t& s, bytes_t end, const ByteSet& set)
+{
+  __m128i members[sizeof(set.Bytes)];
+  for (size_t i = 0; i < set.Count; ++i)
+    members[i] = _mm_set1_epi8(set.Bytes[i]);
+
+  size_t n = 0;
+  for (; end - s >= 16; s += 16)
+    n += PopCount(MatchSse2(s, members, set.Count));
+
+  return n;
+}
+#endif
+
+#ifdef UTF8_AVX2
+// Any set: byte (h << 4) | l matches when Nibbles[l] has bit h. The high
+// nibble table has no bits for h >= 8, so non-ASCII bytes never match
+UTF8_TARGET_AVX2
+static inline uint32_t MatchAvx2(bytes_t s, __m256i low)
+{
+  const __m256i high = _mm256_setr_epi8(
+    1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0
+  );
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+  __m256i v = _mm256_loadu_si256((const __m256i*)s);
+  __m256i lo = _mm256_shuffle_epi8(low, _mm256_and_si256(v, nibble));
+  __m256i hi = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+
+  __m256i none = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+  return ~uint32_t(_mm256_movemask_epi8(none));
+}
+
+UTF8_TARGET_AVX2
+static bool FindByteAvx2(bytes_t& s, bytes_t end, const ByteSet& set)
+{
+  const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set.Nibbles));
+
+  for (; end - s >= 32; s += 32)
+  {
+    uint32_t mask = MatchAvx2(s, low);
+    if (mask)
+    {
+      s += CountTrailingZeros(mask);
+      return true;
+    }
+  }
+  return false;
+}
+
+UTF8_TARGET_AVX2
+static size_t CountBytesAvx2(bytes_t& s, bytes_t end, const ByteSet& set)
+{
+  const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set.Nibbles));
+
+  size_t n = 0;
+  for (; end - s >= 32; s += 32)
+    n += PopCount(MatchAvx2(s, low));
+
+  return n;
+}
+#endif
+
+size_t simd::FindByte(const char* ptr, size_t size, const ByteSet& set)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+
+  if (set.Count == 0)
+    return size;
+
+#ifdef UTF8_AVX2
+  if (size >= 32 && HasAvx2() && FindByteAvx2(s, end, set))
+    return size_t(s - (bytes_t)ptr);
+#endif
+
+#ifdef UTF8_SSE2
+  if (set.Count <= sizeof(set.Bytes) && FindByteSse2(s, end, set))
+    return size_t(s - (bytes_t)ptr);
+#endif
+
+  return size_t(FindByteScalar(s, end, set) - (bytes_t)ptr);
+}
+
+size_t simd::CountBytes(const char* ptr, size_t size, const ByteSet& set)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+  size_t n = 0;
+
+  if (set.Count == 0)
+    return 0;
+
+#ifdef UTF8_AVX2
+  if (size >= 32 && HasAvx2())
+    n += CountBytesAvx2(s, end, set);
+#endif
+
+#ifdef UTF8_SSE2
+  if (set.Count <= sizeof(set.Bytes))
+    n += CountBytesSse2(s, end, set);
+#endif
+
+  for (; s < end; ++s)
+    n += *s < 0x80 && ((set.Bits[*s >> 6] >> (*s & 63)) & 1);
+
+  return n;
+}
+
+static bytes_t VerifyScalar(bytes_t s, bytes_t end)
+{
+  while (s < end)
+  {
+    if (*s < 0x80)
+    {
+      s = SkipAscii(s, end); // 0xxxxxxx
+      continue;
+    }
+
+    size_t left = size_t(end - s);
+
+    if ((s[0] & 0xe0) == 0xc0)
+    {
+      // 110XXXXx 10xxxxxx
+      if (left < 2 ||
+          (s[1] & 0xc0) != 0x80 ||
+          (s[0] & 0xfe) == 0xc0   // overlong?
+      )
+      {
+        return s;
+      }
+      s += 2;
+      continue;
+    }
+
+    if ((s[0] & 0xf0) == 0xe0)
+    {
+      // 1110XXXX 10Xxxxxx 10xxxxxx
+      if (left < 3 ||
+          (s[1] & 0xc0) != 0x80 ||
+          (s[2] & 0xc0) != 0x80 ||
+          (s[0] == 0xe0 && (s[1] & 0xe0) == 0x80) ||              // overlong?
+          (s[0] == 0xed && (s[1] & 0xe0) == 0xa0) ||              // surrogate?
+          (s[0] == 0xef && s[1] == 0xbf && (s[2] & 0xfe) == 0xbe) // U+FFFE or U+FFFF?
+      )
+      {
+        return s;
+      }
+      s += 3;
+      continue;
+    }
+
+    if ((s[0] & 0xf8) == 0xf0)
+    {
+      // 11110XXX 10XXxxxx 10xxxxxx 10xxxxxx
+      if (left < 4 ||
+          (s[1] & 0xc0) != 0x80 ||
+          (s[2] & 0xc0) != 0x80 ||
+          (s[3] & 0xc0) != 0x80 ||
+          (s[0] == 0xf0 && (s[1] & 0xf0) == 0x80) ||    // overlong?
+          (s[0] == 0xf4 && s[1] > 0x8f) || s[0] > 0xf4   // > U+10FFFF?
+      )
+      {
+        return s;
+      }
+      s += 4;
+      continue;
+    }
+    return s;
+  }
+  return nullptr;
+}
+
+// Everything before p has been checked by a block validator but a sequence
+// may straddle p. Returns the start of that sequence (or p itself), so that
+// the scalar validator can resume from a character boundary
+static bytes_t Resync(bytes_t start, bytes_t p)
+{
+  for (int k = 1; k <= 3 && p - k >= start; ++k)
+  {
+    unsigned char b = p[-k];
+    if (b < 0x80)
+      break;
+
+    if (b >= 0xc0)
+      return p - k;
+  }
+  return p;
+}
+
+#ifdef UTF8_AVX2
+
+// Lookup table validation, see "Validating UTF-8 In Less Than One Instruction
+// Per Byte" (J. Keiser, D. Lemire). Each pair of adjacent bytes is classified
+// by three 16-entry tables (high nibble of the first byte, low nibble of the
+// first byte, high nibble of the second byte). The AND of the three lookups
+// is non-zero for invalid pairs. 3 and 4 byte sequences additionally require
+// that bytes 2/3 positions after a lead byte are continuation bytes
+
+#define TOO_SHORT      (1 << 0)
+#define TOO_LONG       (1 << 1)
+#define OVERLONG_3     (1 << 2)
+#define TOO_LARGE      (1 << 3)
+#define SURROGATE      (1 << 4)
+#define OVERLONG_2     (1 << 5)
+#define TOO_LARGE_1000 (1 << 6)
+#define OVERLONG_4     (1 << 6)
+#define TWO_CONTS      (1 << 7)
+#define CARRY          (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+#define TABLE16(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+UTF8_TARGET_AVX2
+static inline __m256i Prev(__m256i input, __m256i prev, int n)
+{
+  __m256i shifted = _mm256_permute2x128_si256(prev, input, 0x21);
+  switch (n)
+  {
+    case 1: return _mm256_alignr_epi8(input, shifted, 15);
+    case 2: return _mm256_alignr_epi8(input, shifted, 14);
+    default: return _mm256_alignr_epi8(input, shifted, 13);
+  }
+}
+
+UTF8_TARGET_AVX2
+static inline __m256i Nibble(__m256i v)
+{
+  return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+}
+
+UTF8_TARGET_AVX2
+static inline __m256i CheckBlockAvx2(__m256i input, __m256i prevInput)
+{
+  const __m256i byte1High = TABLE16(
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+  );
+
+  const __m256i byte1Low = TABLE16(
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+  );
+
+  const __m256i byte2High = TABLE16(
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+  );
+
+  __m256i prev1 = Prev(input, prevInput, 1);
+  __m256i prev2 = Prev(input, prevInput, 2);
+  __m256i prev3 = Prev(input, prevInput, 3);
+
+  __m256i special = _mm256_and_si256(
+    _mm256_and_si256(
+      _mm256_shuffle_epi8(byte1High, Nibble(prev1))
+      , _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0f)))
+    )
+    , _mm256_shuffle_epi8(byte2High, Nibble(input))
+  );
+
+  // Bytes 2 or 3 positions after a 3/4 byte lead must be continuations
+  __m256i must23 = _mm256_or_si256(
+    _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80)))
+    , _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)))
+  );
+  __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8(char(0x80)));
+  __m256i error = _mm256_xor_si256(must23_80, special);
+
+  // EF BF BE / EF BF BF (U+FFFE, U+FFFF)
+  __m256i nonchar = _mm256_and_si256(
+    _mm256_and_si256(
+      _mm256_cmpeq_epi8(prev2, _mm256_set1_epi8(char(0xef)))
+      , _mm256_cmpeq_epi8(prev1, _mm256_set1_epi8(char(0xbf)))
+    )
+    , _mm256_cmpeq_epi8(_mm256_or_si256(input, _mm256_set1_epi8(1)), _mm256_set1_epi8(char(0xbf)))
+  );
+
+  return _mm256_or_si256(error, nonchar);
+}
+
+UTF8_TARGET_AVX2
+static bytes_t VerifyAvx2(bytes_t s, bytes_t end)
+{
+  // Lead bytes in the last 3 positions that need more bytes than are left
+  const __m256i maxValue = _mm256_setr_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    , char(0xf0 - 1), char(0xe0 - 1), char(0xc0 - 1)
+  );
+
+  __m256i prevInput = _mm256_setzero_si256();
+  __m256i prevIncomplete = _mm256_setzero_si256();
+
+  bytes_t p = s;
+  for (; end - p >= 32; p += 32)
+  {
+    __m256i input = _mm256_loadu_si256((const __m256i*)p);
+    __m256i error;
+
+    if (_mm256_movemask_epi8(input) == 0)
+    {
+      error = prevIncomplete;
+      prevIncomplete = _mm256_setzero_si256();
+    }
+    else
+    {
+      error = CheckBlockAvx2(input, prevInput);
+      prevIncomplete = _mm256_subs_epu8(input, maxValue);
+    }
+
+    if (!_mm256_testz_si256(error, error))
+      break;
+
+    prevInput = input;
+  }
+
+  return Resync(s, p);
+}
+
+#endif // #ifdef UTF8_AVX2
+
+const char* simd::Verify(const char* ptr, size_t size)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+
+#ifdef UTF8_AVX2
+  if (size >= 32 && HasAvx2())
+    s = VerifyAvx2(s, end);
+#endif
+
+  return (const char*)VerifyScalar(s, end);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <utf8/CodePointSet.h>
+
+// Internal vectorized kernels shared by String and the converters. Each
+// kernel has a portable scalar implementation. SSE2 is used on x86 when the
+// compiler targets it, AVX2 is selected at run time when the CPU supports it.
+// Define UTF8_NO_SIMD (cmake -DUTF8_SIMD=OFF) to build the scalar code only
+
+#ifndef UTF8_NO_SIMD
+  #if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define UTF8_SSE2
+  #endif
+
+  #if defined(UTF8_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+    #define UTF8_AVX2
+  #endif
+#endif
+
+#if defined(UTF8_AVX2) && defined(__GNUC__)
+  #define UTF8_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+  #define UTF8_TARGET_AVX2
+#endif
+
+namespace utf8
+{
+  namespace simd
+  {
+    bool HasAvx2();
+
+    // Offset of the first byte of [ptr, ptr + size) that belongs to set or
+    // size if there is none. Bytes >= 0x80 never match, so UTF-8 text can be
+    // searched for ASCII delimiters without decoding
+    size_t FindByte(const char* ptr, size_t size, const ByteSet& set);
+
+    // Number of bytes of [ptr, ptr + size) that belong to set
+    size_t CountBytes(const char* ptr, size_t size, const ByteSet& set);
+
+    // Number of leading bytes of [ptr, ptr + size) that are 7-bit ASCII
+    size_t AsciiPrefix(const char* ptr, size_t size);
+
+    // Number of characters: bytes other than 10xxxxxx continuation bytes
+    size_t CountChars(const char* ptr, size_t size);
+
+    // Pointer to the character n characters after ptr or end if the text
+    // is shorter
+    const char* SkipChars(const char* ptr, const char* end, size_t n);
+
+    // Returns pointer to the lead byte of the first invalid sequence in
+    // [ptr, ptr + size) or nullptr if the whole range is valid. Overlongs,
+    // surrogates, code points above U+10FFFF and U+FFFE/U+FFFF are rejected
+    const char* Verify(const char* ptr, size_t size);
+  }
+}
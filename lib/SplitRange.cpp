@@ -0,0 +1,90 @@
+#include <utf8/SplitRange.h>
+#include <utf8/String.h>
+
+#include "Simd.h"
+
+using namespace utf8;
+
+static ByteSet DelimiterBytes(const CodePointSet& delimiters)
+{
+  // NUL ends the text as it does for Split
+  uint64_t bits[2] = { delimiters.AsciiBits()[0] | 1, delimiters.AsciiBits()[1] };
+  return ByteSet(bits);
+}
+
+SplitRange::iterator::iterator()
+  : Range(nullptr)
+  , Next(nullptr)
+  , Current(nullptr, 0, 0)
+{
+}
+
+SplitRange::iterator& SplitRange::iterator::operator++()
+{
+  if (Next)
+    Range->Scan(*this, Next);
+  else
+    Current = Token(nullptr, 0, 0);
+
+  return *this;
+}
+
+SplitRange::iterator SplitRange::iterator::operator++(int)
+{
+  iterator it = *this;
+  ++*this;
+  return it;
+}
+
+SplitRange::SplitRange(const char* ptr, size_t size, const CodePointSet& delimiters)
+  : Begin(ptr)
+  , End(ptr + size)
+  , Delimiters(delimiters)
+  , Ascii(delimiters.IsAscii())
+  , Bytes(DelimiterBytes(delimiters))
+{
+}
+
+SplitRange::iterator SplitRange::begin() const
+{
+  iterator it;
+  it.Range = this;
+
+  if (Begin != End)
+    Scan(it, Begin);
+
+  return it;
+}
+
+SplitRange::iterator SplitRange::end() const
+{
+  iterator it;
+  it.Range = this;
+  return it;
+}
+
+void SplitRange::Scan(iterator& it, const char* p) const
+{
+  const char* start = p;
+  size_t n = 0;
+  size_t len = 0;
+
+  if (Ascii)
+  {
+    p += simd::FindByte(p, End - p, Bytes);
+    n = p < End && *p ? 1 : 0;
+    len = simd::CountChars(start, p - start);
+  }
+  else
+  {
+    for (;; p += n, ++len)
+    {
+      n = p < End ? String::CharSize(p) : 0;
+      if (!n || Delimiters.Contains(p, n))
+        break;
+    }
+  }
+
+  it.Current = Token(start, size_t(p - start), len);
+  it.Next = n ? p + n : nullptr;
+}
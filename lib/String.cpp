@@ -10,31 +10,67 @@
 #include <utf8/Convert.h>
 #include <utf8/String.h>
 
+#include "CaseMap.h"
+#include "Simd.h"
+
 #ifdef _WIN32
   #include <icu.h>
 #endif
 
 using namespace utf8;
 
+static size_t CountChars(const char* p, size_t size)
+{
+  return simd::CountChars(p, size);
+}
+
+static size_t CountChars(const std::string& str)
+{
+  return CountChars(str.c_str(), str.size());
+}
+
+// The index is only built for strings at least this long (in bytes) and
+// stores the byte offset of every IndexStep-th character
+#define INDEX_MIN_SIZE 256
+#define INDEX_STEP     64
+
+struct String::Index
+{
+  std::vector<size_t> Offsets;  // Offsets[k] is offset of character k * INDEX_STEP
+};
+
 String::String()
+  : Len(0)
 {
 }
 
 String::String(const String& str)
+  : Data(str.Data)
+  , Len(str.Len)
 {
-  Data = str.Data;
 }
 
 String::String(String&& str) noexcept
   : Data(std::move(str.Data))
+  , Len(str.Len)
+  , Positions(str.Positions.exchange(nullptr))
 {
+  str.Data.clear();
+  str.Len = 0;
+}
+
+String::~String()
+{
+  delete Positions.load(std::memory_order_relaxed);
 }
 
 String::String(const Char& ch, size_t n)
+  : Len(ch.empty() ? 0 : n)
 {
   std::string str = ch.Str();
   ASSERT_VALID_UTF8(str);
 
+  Data.reserve(str.size() * n);
   for (size_t i = 0; i < n; ++i)
     Data += str;
 }
@@ -42,11 +78,13 @@ String::String(const Char& ch, size_t n)
 String::String(const AnsiPtr& ptr)
 {
   Data = AnsiToUtf8(ptr);
+  Len = CountChars(Data);
   ASSERT_VALID_UTF8(Data);
 }
 
 String::String(const Utf8Ptr& ptr)
   : Data(ptr)
+  , Len(CountChars(Data))
 {
   ASSERT_VALID_UTF8(Data);
 }
@@ -54,6 +92,7 @@ String::String(const Utf8Ptr& ptr)
 String::String(const w16string& str)
 {
   Data = Utf16ToUtf8(str.c_str());
+  Len = CountChars(Data);
   ASSERT_VALID_UTF8(Data);
 }
 
@@ -61,30 +100,41 @@ String::String(const w16_type* ptr, size_t n)
 {
   w16string str(ptr, n == -1 ? w16_strlen(ptr) : n);
   Data = Utf16ToUtf8(str.c_str());
+  Len = CountChars(Data);
   ASSERT_VALID_UTF8(Data);
 }
 
 String::String(const w32string& str)
 {
-  Data = Utf32ToUtf8(str.c_str());
+  Data = Utf32ToUtf8(str.c_str(), str.size());
+  Len = CountChars(Data);
   ASSERT_VALID_UTF8(Data);
 }
 
 String::String(const w32_type* ptr, size_t n)
 {
-  w32string str(ptr, n == -1 ? w32_strlen(ptr) : n);
-  Data = Utf32ToUtf8(str.c_str());
+  Data = Utf32ToUtf8(ptr, n == -1 ? w32_strlen(ptr) : n);
+  Len = CountChars(Data);
   ASSERT_VALID_UTF8(Data);
 }
 
 String::String(const char* utf8, size_t n)
   : Data(utf8, n == -1 ? strlen(utf8) : n)
+  , Len(CountChars(Data))
 {
   ASSERT_VALID_UTF8(Data);
 }
 
 String::String(const std::string& utf8)
   : Data(utf8)
+  , Len(CountChars(Data))
+{
+  ASSERT_VALID_UTF8(Data);
+}
+
+String::String(std::string&& utf8)
+  : Data(std::move(utf8))
+  , Len(CountChars(Data))
 {
   ASSERT_VALID_UTF8(Data);
 }
@@ -93,6 +143,7 @@ String::String(const std::string& utf8)
 String::String(const wxString& string)
 {
     Data = std::string(string.mb_str(wxConvUTF8));
+    Len = CountChars(Data);
     ASSERT_VALID_UTF8(Data);
 }
 #endif
@@ -175,28 +226,12 @@ size_t String::CharSize(const char* p)
 
 bool String::Empty() const
 {
-  return Length() == 0;
+  return Data.empty();
 }
 
 size_t String::Length() const
 {
-  size_t len = 0;
-  size_t bytes = 0;
-  size_t size = Data.size();
-  for (const char* p = Data.c_str(); *p;)
-  {
-    size_t n = CharSize(p);
-    if (!n)
-      break;
-
-    len++;
-    p += n;
-    bytes += n;
-
-    if (bytes > size)
-      return 0;
-  }
-  return len;
+  return Len;
 }
 
 size_t String::Size() const
@@ -206,44 +241,28 @@ size_t String::Size() const
 
 size_t String::SizeOf(size_t charIndex) const
 {
-  for (const char* p = Data.c_str(); *p;)
-  {
-    size_t n = CharSize(p);
-    if (!n)
-      break;
-
-    if (!charIndex--)
-      return n;
+  if (charIndex >= Len)
+    return 0;
 
-    p += n;
-  }
-  return 0;
+  return CharSize(c_str() + ByteOffset(charIndex));
 }
 
 size_t String::OffsetOf(size_t charIndex) const
 {
-  size_t offset = 0;
-  for (const char* p = Data.c_str(); *p;)
-  {
-    size_t n = CharSize(p);
-    if (!n)
-      break;
-
-    if (!charIndex--)
-      return offset;
+  if (charIndex >= Len)
+    return 0;
 
-    p += n;
-    offset += n;
-  }
-  return 0;
+  return ByteOffset(charIndex);
 }
 
 Char String::CharAt(size_t charIndex) const
 {
   Char ch;
+  if (charIndex >= Len)
+    return ch;
 
-  size_t size = SizeOf(charIndex);
-  for (const char* p = &Data[0] + OffsetOf(charIndex); size; --size)
+  const char* p = c_str() + ByteOffset(charIndex);
+  for (size_t size = CharSize(p); size; --size)
     ch.push_back(*p++);
 
   return ch;
@@ -262,53 +281,84 @@ Char String::LastChar() const
   return CharAt(Length() - 1);
 }
 
+String::const_iterator String::begin() const
+{
+  return const_iterator(Data.c_str());
+}
+
+String::const_iterator String::end() const
+{
+  return const_iterator(Data.c_str() + Data.size());
+}
+
+String::const_reverse_iterator String::rbegin() const
+{
+  return const_reverse_iterator(end());
+}
+
+String::const_reverse_iterator String::rend() const
+{
+  return const_reverse_iterator(begin());
+}
+
 bool String::RemoveAt(size_t charIndex)
 {
-  size_t len = Length();
-  if (len <= charIndex)
+  if (Len <= charIndex)
     return false;
 
-  size_t pos = OffsetOf(charIndex);
+  size_t pos = ByteOffset(charIndex);
   size_t cb = CharSize(c_str() + pos);
 
-  Data = Data.substr(0, pos) + Data.substr(pos + cb);
+  Data.erase(pos, cb);
+  Len--;
+  ShiftIndex(charIndex, -ptrdiff_t(cb), -1);
   return true;
 }
 
 bool String::InsertAt(size_t charIndex, const Char& ch)
 {
-  size_t len = Length();
   if (charIndex == std::string::npos)
-    charIndex = len;
+    charIndex = Len;
 
-  if (len < charIndex)
+  if (Len < charIndex)
     return false;
 
-  size_t pos;
-  if (charIndex == len)
-    pos = Data.size();
-  else
-     pos = OffsetOf(charIndex);
-     
-  Data = Data.substr(0, pos) + ch.Str() + Data.substr(pos);
+  if (ch.empty())
+    return true;
+
+  Data.insert(ByteOffset(charIndex), ch.data(), ch.size());
+  Len++;
+  ShiftIndex(charIndex, ptrdiff_t(ch.size()), 1);
   return true;
 }
 
 bool String::ReplaceAt(size_t charIndex, const Char& ch)
 {
-  size_t len = Length();
-  if (len <= charIndex)
+  if (Len <= charIndex)
     return false;
 
-  size_t pos = OffsetOf(charIndex);
+  size_t pos = ByteOffset(charIndex);
   size_t cb = CharSize(c_str() + pos);
-  Data = Data.substr(0, pos) + ch.Str() + Data.substr(pos + cb);
+
+  if (cb == ch.size())
+  {
+    // Byte offsets do not move, the index stays valid
+    memcpy(&Data[pos], ch.data(), cb);
+    return true;
+  }
+
+  Data.replace(pos, cb, ch.data(), ch.size());
+  if (ch.empty())
+    Len--;
+  ShiftIndex(charIndex, ptrdiff_t(ch.size()) - ptrdiff_t(cb), ch.empty() ? -1 : 0);
   return true;
 }
 
 void String::Clear()
 {
   Data.clear();
+  Len = 0;
+  DropIndex();
 }
 
 void String::ToLowerCase()
@@ -321,9 +371,17 @@ void String::ToLowerCase()
     dst += u_tolower(c);
 
   Data = Utf32ToUtf8(dst.c_str());
+  Len = CountChars(Data);
 #elif defined(__APPLE__)
   Data = Utf8ToLower(Data.c_str());
+  Len = CountChars(Data);
+#else
+  std::string data;
+  data.reserve(Data.size());
+  Len = casemap::Map(casemap::Lower, Data.c_str(), Data.size(), data);
+  Data.swap(data);
 #endif
+  DropIndex();
 }
 
 void String::ToUpperCase()
@@ -336,9 +394,17 @@ void String::ToUpperCase()
     dst += u_toupper(c);
 
   Data = Utf32ToUtf8(dst.c_str());
+  Len = CountChars(Data);
 #elif defined(__APPLE__)
   Data = Utf8ToUpper(Data.c_str());
+  Len = CountChars(Data);
+#else
+  std::string data;
+  data.reserve(Data.size());
+  Len = casemap::Map(casemap::Upper, Data.c_str(), Data.size(), data);
+  Data.swap(data);
 #endif
+  DropIndex();
 }
 
 void String::Trim(const Char& space)
@@ -356,12 +422,16 @@ void String::TrimLeft(const Char& space)
       continue;
 
     if (i)
+    {
       Data = Data.substr(OffsetOf(i));
+      Len -= i;
+      DropIndex();
+    }
 
     return;
   }
 
-  Data.clear();
+  Clear();
 }
 
 void String::TrimRight(const Char& space)
@@ -376,12 +446,72 @@ void String::TrimRight(const Char& space)
       continue;
 
     if (i != int(len - 1))
+    {
       Data = Data.substr(0, OffsetOf(size_t(i) + 1));
+      Len = size_t(i) + 1;
+      PatchIndex(Len);
+    }
 
     return;
   }
 
-  Data.clear();
+  Clear();
+}
+
+void String::Trim(const CodePointSet& spaces)
+{
+  TrimLeft(spaces);
+  TrimRight(spaces);
+}
+
+void String::TrimLeft(const CodePointSet& spaces)
+{
+  const char* p0 = Data.c_str();
+  const char* p = p0;
+  size_t count = 0;
+
+  for (;;)
+  {
+    size_t n = CharSize(p);
+    if (!n || !spaces.Contains(p, n))
+      break;
+
+    p += n;
+    count++;
+  }
+
+  if (!count)
+    return;
+
+  Data.erase(0, p - p0);
+  Len -= count;
+  DropIndex();
+}
+
+void String::TrimRight(const CodePointSet& spaces)
+{
+  size_t end = Data.size();
+  size_t count = 0;
+
+  while (end)
+  {
+    size_t start = end - 1;
+    while (start && (Data[start] & 0xC0) == 0x80)
+      start--;
+
+    if (!spaces.Contains(&Data[start], end - start))
+      break;
+
+    end = start;
+    count++;
+  }
+
+  if (!count)
+    return;
+
+  Data.resize(end);
+  Len -= count;
+  PatchIndex(Len);
 }
 
 void String::Remove(const Char& ch)
@@ -412,120 +542,266 @@ void String::Remove(const Char& ch)
 
     cb -= n;
     size -= n;
+    Len--;
     memmove(p, p + n, cb);
   }
 
   Data.resize(size);
+  DropIndex();
 }
 
-void String::Replace(const Char& find, const Char& replace)
+void String::Remove(const CodePointSet& chars)
 {
-  if (find == replace)
-    return;
+  char* dst = &Data[0];
+  const char* p = Data.c_str();
+  const char* end = p + Data.size();
+  size_t removed = 0;
 
-  while (true)
+  while (p < end)
   {
-    size_t index = IndexOf(find);
-    if (index == std::string::npos)
-      break;
+    // An embedded NUL is a one byte character, the text goes on after it
+    size_t n = CharSize(p);
+    if (!n)
+      n = 1;
+
+    if (chars.Contains(p, n))
+      removed++;
+    else
+    {
+      if (dst != p)
+        memmove(dst, p, n);
+      dst += n;
+    }
 
-    ReplaceAt(index, replace);
+    p += n;
   }
+
+  if (!removed)
+    return;
+
+  Data.resize(dst - Data.c_str());
+  Len -= removed;
+  DropIndex();
 }
 
-bool String::ReplaceString(const String& find, const String& replace)
+void String::Replace(const Char& find, const Char& replace)
 {
-  bool result = false;
-  size_t startPos = 0;
-  size_t newStartPos = 0;
-  while ((newStartPos = IndexOf(find, startPos)) != std::string::npos)
+  if (find.empty() || find == replace)
+    return;
+
+  if (find.size() != replace.size())
   {
-    *this = Substr(0, newStartPos) + replace + Substr(newStartPos + find.Length());
-    startPos = newStartPos + replace.Length();
-    result = true;
+    ReplaceAll(StringView(find.data(), find.size(), 1), StringView(replace.data(), replace.size(), replace.empty() ? 0 : 1));
+    return;
   }
 
-  return result;
+  // Same size: byte offsets do not move, the index stays valid
+  for (size_t pos = 0; (pos = Data.find(find.data(), pos, find.size())) != std::string::npos; pos += find.size())
+    memcpy(&Data[pos], replace.data(), replace.size());
 }
 
-String String::Substr(size_t pos, size_t count) const
+void String::Replace(const CodePointSet& find, const Char& replace)
 {
-  size_t len = Length();
-  if (pos >= len)
-    return String();
-
   std::string str;
+  str.reserve(Data.size());
 
-  size_t end = pos + count;
-  for (const char* p = c_str() + OffsetOf(pos); pos < len && *p; ++pos)
+  const char* p = Data.c_str();
+  const char* end = p + Data.size();
+  size_t count = 0;
+
+  while (p < end)
   {
-    if (count != std::string::npos)
+    // As in Remove, an embedded NUL does not end the text
+    size_t n = CharSize(p);
+    if (!n)
+      n = 1;
+
+    if (find.Contains(p, n))
     {
-      if (pos == end)
-        break;
+      str.append(replace.data(), replace.size());
+      count++;
     }
+    else
+      str.append(p, n);
+
+    p += n;
+  }
+
+  if (!count)
+    return;
+
+  Data.swap(str);
+  if (replace.empty())
+    Len -= count;
+  DropIndex();
+}
 
+void String::Replace(const CharMap& map)
+{
+  CodePointSet keys;
+  for (auto& item : map)
+    keys.Insert(item.first);
+
+  std::string str;
+  str.reserve(Data.size());
+
+  const char* p = Data.c_str();
+  const char* end = p + Data.size();
+  size_t removed = 0;
+  size_t count = 0;
+
+  while (p < end)
+  {
     size_t n = CharSize(p);
     if (!n)
-      break;
+      n = 1;
 
-    for (size_t i = 0; i < n; ++i)
-      str.push_back(*p++);
+    auto it = map.end();
+    if (keys.Contains(p, n))
+    {
+      Char ch;
+      for (size_t i = 0; i < n; ++i)
+        ch.push_back(p[i]);
+
+      it = map.find(ch);
+    }
+
+    if (it != map.end())
+    {
+      str.append(it->second.data(), it->second.size());
+      removed += it->second.empty();
+      count++;
+    }
+    else
+      str.append(p, n);
+
+    p += n;
   }
 
-  ASSERT_VALID_UTF8(str);
-  return String(Utf8Ptr(str));
+  if (!count)
+    return;
+
+  Data.swap(str);
+  Len -= removed;
+  DropIndex();
 }
 
-StringArray String::Split(const char* delimiters) const
+bool String::ReplaceString(const String& find, const String& replace)
 {
-  CharSet chs;
+  return ReplaceAll(find, replace) != 0;
+}
 
-  size_t size = strlen(delimiters);
-  for (size_t offset = 0; offset < size;)
-  {
-    size_t cb = CharSize(delimiters);
-    if (!cb || offset + cb > size)
-      break;
+size_t String::ReplaceAll(const StringView& find, const StringView& replace)
+{
+  if (find.Empty())
+    return 0;
 
-    Char ch;
-    for (size_t i = 0; i < cb; ++i)
-      ch.push_back(delimiters[i]);
+  std::vector<size_t> matches;
+  for (size_t pos = 0; (pos = Data.find(find.data(), pos, find.Size())) != std::string::npos; pos += find.Size())
+    matches.push_back(pos);
 
-    chs.insert(ch);
+  if (matches.empty())
+    return 0;
+
+  size_t count = matches.size();
+
+  std::string str;
+  str.reserve(Data.size() - count * find.Size() + count * replace.Size());
 
-    delimiters += cb;
-    offset += cb;
+  size_t pos = 0;
+  for (size_t match : matches)
+  {
+    str.append(Data, pos, match - pos);
+    str.append(replace.data(), replace.Size());
+    pos = match + find.Size();
   }
+  str.append(Data, pos, std::string::npos);
+
+  Data.swap(str);
+  Len = Len - count * find.Length() + count * replace.Length();
+  DropIndex();
 
-  return Split(chs);
+  ASSERT_VALID_UTF8(Data);
+  return count;
+}
+
+String String::Substr(size_t pos, size_t count) const
+{
+  size_t len = Length();
+  if (pos >= len)
+    return String();
+
+  size_t n = std::min(count, len - pos);
+
+  const char* p0 = c_str() + OffsetOf(pos);
+  const char* p = p0;
+  for (size_t i = 0; i < n; ++i)
+    p += CharSize(p);
+
+  String str;
+  str.Data.assign(p0, p - p0);
+  str.Len = n;
+
+  ASSERT_VALID_UTF8(str.Data);
+  return str;
+}
+
+StringArray String::Split(const char* delimiters) const
+{
+  return Split(CodePointSet(delimiters));
 }
 
 StringArray String::Split(const CharSet& delimiters) const
+{
+  return Split(CodePointSet(delimiters));
+}
+
+StringArray String::Split(const CodePointSet& delimiters) const
 {
   StringArray tokens;
 
   if (Empty())
       return tokens;
 
+  if (delimiters.IsAscii())
+  {
+    // UTF-8 lead and continuation bytes never equal an ASCII delimiter, so
+    // the bytes can be scanned without decoding. NUL ends the string as
+    // it does in the loop below
+    uint64_t bits[2] = { delimiters.AsciiBits()[0] | 1, delimiters.AsciiBits()[1] };
+    ByteSet set(bits);
+
+    const char* p = Data.c_str();
+    const char* end = p + Data.size();
+
+    // Growing the array costs more than counting the delimiters first
+    tokens.reserve(simd::CountBytes(p, end - p, set) + 1);
+
+    for (;;)
+    {
+      size_t n = simd::FindByte(p, end - p, set);
+      tokens.push_back(String(p, n));
+
+      p += n;
+      if (p == end || *p == '\0')
+        break;
+
+      p++;
+    }
+
+    return tokens;
+  }
+
   const char* start = nullptr;
   const char* p = Data.c_str();
 
-  Char ch;
-  ch.reserve(3);
-
   for (;;)
   {
     size_t n = CharSize(p);
     if (!n)
       break;
 
-    ch.clear();
-    for (size_t i = 0; i < n; ++i)
-      ch.push_back(p[i]);
-
-    auto r = delimiters.find(ch);
-    if (r == delimiters.end())
+    if (!delimiters.Contains(p, n))
     {
       if (start == nullptr)
         start = p;
@@ -551,6 +827,11 @@ StringArray String::Split(const CharSet& delimiters) const
   return tokens;
 }
 
+SplitRange String::Tokenize(const CodePointSet& delimiters) const
+{
+  return SplitRange(Data.c_str(), Data.size(), delimiters);
+}
+
 String String::Join(
   const StringArray& arr
   , const Char& delimiter
@@ -569,9 +850,15 @@ String String::Join(
   return str;
 }
 
+bool String::StartsWith(const StringView& str) const
+{
+  return str.Size() <= Data.size() && Data.compare(0, str.Size(), str.data(), str.Size()) == 0;
+}
+
 bool String::StartsWith(const String& str) const
 {
-  return Data.find(str.Data) == 0;
+  StringView view = str;
+  return StartsWith(view);
 }
 
 bool String::StartsWith(const AnsiPtr& ptr) const
@@ -612,30 +899,28 @@ bool String::StartsWith(const w32_type* ptr) const
 
 bool String::StartsWith(const Char& ch) const
 {
-  String utf8(ch, 1);
-  return StartsWith(utf8);
+  return StartsWith(StringView(ch.data(), ch.size()));
 }
 
 bool String::StartsWith(const char* ptr) const
 {
-  String utf8(ptr);
-  return StartsWith(utf8);
+  return StartsWith(StringView(ptr));
 }
 
 bool String::StartsWith(const std::string& str) const
 {
-  String utf8(str);
-  return StartsWith(utf8);
+  return StartsWith(StringView(str));
 }
 
-bool String::EndsWith(const String& str) const
+bool String::EndsWith(const StringView& str) const
 {
-  size_t l0 = Length();
-  size_t l1 = str.Length();
-  if (l1 > l0)
-    return false;
+  return str.Size() <= Data.size() && Data.compare(Data.size() - str.Size(), str.Size(), str.data(), str.Size()) == 0;
+}
 
-  return Data.rfind(str.Data) == l0 - l1;
+bool String::EndsWith(const String& str) const
+{
+  StringView view = str;
+  return EndsWith(view);
 }
 
 bool String::EndsWith(const AnsiPtr& ptr) const
@@ -676,30 +961,31 @@ bool String::EndsWith(const w32_type* ptr) const
 
 bool String::EndsWith(const Char& ch) const
 {
-  String utf8(ch, 1);
-  return EndsWith(utf8);
+  return EndsWith(StringView(ch.data(), ch.size()));
 }
 
 bool String::EndsWith(const char* ptr) const
 {
-  String utf8(ptr);
-  return EndsWith(utf8);
+  return EndsWith(StringView(ptr));
 }
 
 bool String::EndsWith(const std::string& str) const
 {
-  String utf8(str);
-  return EndsWith(utf8);
+  return EndsWith(StringView(str));
 }
 
-bool String::Includes(const String& str, size_t pos) const
+bool String::Includes(const StringView& str, size_t pos) const
 {
-  size_t len = Length();
-  if (pos >= len)
+  if (pos >= Length())
     return false;
 
-  const char* p0 = c_str() + OffsetOf(pos);
-  return strstr(p0, str.Data.c_str()) != nullptr;
+  return Data.find(str.data(), OffsetOf(pos), str.Size()) != std::string::npos;
+}
+
+bool String::Includes(const String& str, size_t pos) const
+{
+  StringView view = str;
+  return Includes(view, pos);
 }
 
 bool String::Includes(const AnsiPtr& ptr, size_t pos) const
@@ -740,75 +1026,171 @@ bool String::Includes(const w32_type* ptr, size_t pos) const
 
 bool String::Includes(const Char& ch, size_t pos) const
 {
-  String utf8(ch, 1);
-  return Includes(utf8, pos);
+  return Includes(StringView(ch.data(), ch.size()), pos);
 }
 
 bool String::Includes(const char* ptr, size_t pos) const
 {
-  String utf8(ptr);
-  return Includes(utf8, pos);
+  return Includes(StringView(ptr), pos);
 }
 
 bool String::Includes(const std::string& str, size_t pos) const
 {
-  String utf8(str);
-  return Includes(utf8, pos);
+  return Includes(StringView(str), pos);
 }
 
 size_t String::PtrToPos(const char* p0) const
 {
-  size_t index = 0;
-  size_t bytes = 0;
-  size_t size = Data.size();
+  if (p0 < Data.c_str() || p0 >= Data.c_str() + Data.size())
+    return std::string::npos;
 
-  for (const char* p = Data.c_str(); *p;)
-  {
-    if (p == p0)
-      return index;
+  if ((*p0 & 0xC0) == 0x80)
+    return std::string::npos; // Not a character boundary
 
-    size_t n = CharSize(p);
-    if (!n)
-      return std::string::npos;
+  size_t offset = p0 - Data.c_str();
+  if (Len == Data.size())
+    return offset;
 
-    index++;
-    bytes += n;
-    p += n;
+  const Index* index = GetIndex();
+  if (index == nullptr)
+    return CountChars(Data.c_str(), offset);
 
-    if (bytes > size)
-      return std::string::npos;
-  }
-  return std::string::npos;
+  auto it = std::upper_bound(index->Offsets.begin(), index->Offsets.end(), offset) - 1;
+  size_t k = it - index->Offsets.begin();
+
+  return k * INDEX_STEP + CountChars(Data.c_str() + *it, offset - *it);
 }
 
 size_t String::PosToBitPos(const size_t& pos) const
 {
-  size_t index = 0;
-  size_t bytes = 0;
-  size_t size = Data.size();
+  return ByteOffset(std::min(pos, Len));
+}
+
+size_t String::ByteOffset(size_t charIndex) const
+{
+  if (Len == Data.size())
+    return charIndex; // ASCII only
+
+  if (charIndex >= Len)
+    return Data.size();
+
+  size_t offset = 0;
+  size_t start = 0;
+
+  const Index* index = GetIndex();
+  if (index)
+  {
+    size_t k = std::min(charIndex / INDEX_STEP, index->Offsets.size() - 1);
+    offset = index->Offsets[k];
+    start = k * INDEX_STEP;
+  }
+
+  const char* p = Data.c_str() + offset;
+  return simd::SkipChars(p, Data.c_str() + Data.size(), charIndex - start) - Data.c_str();
+}
+
+const String::Index* String::GetIndex() const
+{
+  if (Data.size() < INDEX_MIN_SIZE || Len == Data.size())
+    return nullptr;
+
+  Index* index = Positions.load(std::memory_order_acquire);
+  if (index)
+    return index;
+
+  // Concurrent readers may build it at the same time, only one is kept
+  Index* built = new Index;
+  BuildIndex(*built);
 
-  for (const char* p = Data.c_str(); *p;)
+  if (Positions.compare_exchange_strong(index, built, std::memory_order_acq_rel))
+    return built;
+
+  delete built;
+  return index;
+}
+
+void String::BuildIndex(Index& index) const
+{
+  if (index.Offsets.empty())
+    index.Offsets.push_back(0);
+
+  size_t k = index.Offsets.size() - 1;
+  const char* p = Data.c_str() + index.Offsets[k];
+  const char* end = Data.c_str() + Data.size();
+
+  for (size_t chars = Len - k * INDEX_STEP; chars > INDEX_STEP; chars -= INDEX_STEP)
   {
-    if (index >= pos)
+    p = simd::SkipChars(p, end, INDEX_STEP);
+    index.Offsets.push_back(p - Data.c_str());
+
+    if (p >= end)
       break;
+  }
+}
 
-    size_t n = CharSize(p);
-    if (!n)
-      return std::string::npos;
+void String::DropIndex()
+{
+  delete Positions.exchange(nullptr);
+}
 
-    index++;
-    bytes += n;
-    p += n;
+void String::PatchIndex(size_t charIndex)
+{
+  Index* index = Positions.load(std::memory_order_relaxed);
+  if (index == nullptr)
+    return;
 
-    if (bytes > size)
-      return std::string::npos;
+  if (Data.size() < INDEX_MIN_SIZE || Len == Data.size())
+  {
+    DropIndex();
+    return;
   }
-  return bytes;
+
+  // Entries up to the first changed character are still valid
+  index->Offsets.resize(std::min(index->Offsets.size(), charIndex / INDEX_STEP + 1));
+  BuildIndex(*index);
 }
 
-size_t String::IndexOf(const String& str, size_t Off) const
+void String::ShiftIndex(size_t charIndex, ptrdiff_t bytes, int chars)
 {
-  size_t pos = Data.find(str.Data, PosToBitPos(Off));
+  Index* index = Positions.load(std::memory_order_relaxed);
+  if (index == nullptr)
+    return;
+
+  if (Data.size() < INDEX_MIN_SIZE || Len == Data.size())
+  {
+    DropIndex();
+    return;
+  }
+
+  // Character k * INDEX_STEP after the edit is the one that was next to it
+  // before: one back after an insert, one ahead after a remove
+  std::vector<size_t>& offsets = index->Offsets;
+  const char* p = Data.c_str();
+
+  for (size_t k = charIndex / INDEX_STEP + 1; k < offsets.size(); ++k)
+  {
+    size_t offset = offsets[k] + bytes;
+    if (chars > 0)
+    {
+      do
+        offset--;
+      while ((p[offset] & 0xC0) == 0x80);
+    }
+    else if (chars < 0)
+      offset += CharSize(p + offset);
+
+    offsets[k] = offset;
+  }
+
+  while (offsets.size() > 1 && (offsets.size() - 1) * INDEX_STEP >= Len)
+    offsets.pop_back();
+
+  BuildIndex(*index);
+}
+
+size_t String::IndexOf(const StringView& str, size_t Off) const
+{
+  size_t pos = Data.find(str.data(), PosToBitPos(Off), str.Size());
 
   if (pos == std::string::npos)
     return std::string::npos;
@@ -816,6 +1198,12 @@ size_t String::IndexOf(const String& str, size_t Off) const
   return PtrToPos(c_str() + pos);
 }
 
+size_t String::IndexOf(const String& str, size_t Off) const
+{
+  StringView view = str;
+  return IndexOf(view, Off);
+}
+
 size_t String::IndexOf(const AnsiPtr& ptr, size_t Off) const
 {
   String utf8(ptr);
@@ -854,31 +1242,34 @@ size_t String::IndexOf(const w32_type* ptr, size_t Off) const
 
 size_t String::IndexOf(const Char& ch, size_t Off) const
 {
-  String utf8(ch, 1);
-  return IndexOf(utf8, Off);
+  return IndexOf(StringView(ch.data(), ch.size()), Off);
 }
 
 size_t String::IndexOf(const char* ptr, size_t Off) const
 {
-  String utf8(ptr);
-  return IndexOf(utf8, Off);
+  return IndexOf(StringView(ptr), Off);
 }
 
 size_t String::IndexOf(const std::string& str, size_t Off) const
 {
-  String utf8(str);
-  return IndexOf(utf8, Off);
+  return IndexOf(StringView(str), Off);
 }
 
-size_t String::LastIndexOf(const String& str) const
+size_t String::LastIndexOf(const StringView& str) const
 {
-  size_t pos = Data.rfind(str.Data);
+  size_t pos = Data.rfind(str.data(), std::string::npos, str.Size());
   if (pos == std::string::npos)
     return std::string::npos;
 
   return PtrToPos(c_str() + pos);
 }
 
+size_t String::LastIndexOf(const String& str) const
+{
+  StringView view = str;
+  return LastIndexOf(view);
+}
+
 size_t String::LastIndexOf(const AnsiPtr& ptr) const
 {
   String utf8(ptr);
@@ -917,20 +1308,22 @@ size_t String::LastIndexOf(const w32_type* ptr) const
 
 size_t String::LastIndexOf(const Char& ch) const
 {
-  String utf8(ch, 1);
-  return LastIndexOf(utf8);
+  return LastIndexOf(StringView(ch.data(), ch.size()));
 }
 
 size_t String::LastIndexOf(const char* ptr) const
 {
-  String utf8(ptr);
-  return LastIndexOf(utf8);
+  return LastIndexOf(StringView(ptr));
 }
 
 size_t String::LastIndexOf(const std::string& str) const
 {
-  String utf8(str);
-  return LastIndexOf(utf8);
+  return LastIndexOf(StringView(str));
+}
+
+bool String::IsEqual(const StringView& str) const
+{
+  return operator==(str);
 }
 
 bool String::IsEqual(const String& str) const
@@ -975,14 +1368,12 @@ bool String::IsEqual(const Char& ch) const
 
 bool String::IsEqual(const char* ptr) const
 {
-  String utf8(ptr);
-  return operator==(utf8);
+  return operator==(StringView(ptr));
 }
 
 bool String::IsEqual(const std::string& str) const
 {
-  String utf8(str);
-  return operator==(utf8);
+  return operator==(StringView(str));
 }
 
 bool String::IsEqualNoCase(const String& str) const
@@ -1050,6 +1441,11 @@ bool String::IsEqualNoCase(const std::string& str) const
   return IsEqualNoCase(utf8);
 }
 
+bool String::operator==(const StringView& str) const
+{
+  return Data.size() == str.Size() && Data.compare(0, Data.size(), str.data(), str.Size()) == 0;
+}
+
 bool String::operator==(const String& str) const
 {
   return Data == str.Data;
@@ -1093,8 +1489,7 @@ bool String::operator==(const w32_type* ptr) const
 
 bool String::operator==(const Char& ch) const
 {
-  String utf8(ch, 1);
-  return Data == utf8.Data;
+  return operator==(StringView(ch.data(), ch.size()));
 }
 
 bool String::operator==(const char* ptr) const
@@ -1107,6 +1502,11 @@ bool String::operator==(const std::string& str) const
   return Data == str;
 }
 
+bool String::operator!=(const StringView& str) const
+{
+  return !operator==(str);
+}
+
 bool String::operator!=(const String& str) const
 {
   return !operator==(str);
@@ -1159,49 +1559,81 @@ bool String::operator!=(const std::string& str) const
 
 String& String::operator=(const String& str)
 {
-  Data = str.ToUtf8();
+  Data = str.Data;
+  Len = str.Len;
+  DropIndex();
+  return *this;
+}
+
+String& String::operator=(String&& str) noexcept
+{
+  if (this != &str)
+  {
+    Data.swap(str.Data);
+    str.Data.clear();
+
+    Len = str.Len;
+    str.Len = 0;
+
+    delete Positions.exchange(str.Positions.exchange(nullptr));
+  }
+
   return *this;
 }
 
 String& String::operator=(const AnsiPtr& ptr)
 {
   Data = AnsiToUtf8(ptr);
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const Utf8Ptr& ptr)
 {
   Data = ptr;
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const w16string& str)
 {
   Data = Utf16ToUtf8(str.c_str());
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const w16_type* ptr)
 {
   Data = Utf16ToUtf8(ptr);
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const w32string& str)
 {
-  Data = Utf32ToUtf8(str.c_str());
+  Data = Utf32ToUtf8(str.c_str(), str.size());
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const w32_type* ptr)
 {
   Data = Utf32ToUtf8(ptr);
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator=(const Char& ch)
 {
   Data = ch.Str();
+  Len = ch.empty() ? 0 : 1;
+  DropIndex();
   return *this;
 }
 
@@ -1210,6 +1642,18 @@ String& String::operator=(const std::string& str)
   ASSERT_VALID_UTF8(str);
 
   Data = str;
+  Len = CountChars(Data);
+  DropIndex();
+  return *this;
+}
+
+String& String::operator=(std::string&& str)
+{
+  ASSERT_VALID_UTF8(str);
+
+  Data = std::move(str);
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
@@ -1218,134 +1662,211 @@ String& String::operator=(const char* ptr)
   ASSERT_VALID_UTF8(ptr);
 
   Data = ptr;
+  Len = CountChars(Data);
+  DropIndex();
   return *this;
 }
 
 String& String::operator+=(const String& str)
 {
-  Data += str.c_str();
-  return *this;
+  return Append(str.Data.c_str(), str.Data.size(), str.Len);
 }
 
 String& String::operator+=(const AnsiPtr& ptr)
 {
-  Data += AnsiToUtf8(ptr);
-  return *this;
+  return Append(AnsiToUtf8(ptr));
 }
 
 String& String::operator+=(const Utf8Ptr& ptr)
 {
-  Data += ptr;
-  return *this;
+  return Append(ptr, strlen(ptr));
 }
 
 String& String::operator+=(const w16string& str)
 {
-  Data += Utf16ToUtf8(str.c_str());
-  return *this;
+  return Append(Utf16ToUtf8(str.c_str()));
 }
 
 String& String::operator+=(const w16_type* ptr)
 {
-  Data += Utf16ToUtf8(ptr);
-  return *this;
+  return Append(Utf16ToUtf8(ptr));
 }
 
 String& String::operator+=(const w32string& str)
 {
-  Data += Utf32ToUtf8(str.c_str());
-  return *this;
+  return Append(Utf32ToUtf8(str.c_str(), str.size()));
 }
 
 String& String::operator+=(const w32_type* ptr)
 {
-  Data += Utf32ToUtf8(ptr);
-  return *this;
+  return Append(Utf32ToUtf8(ptr));
 }
 
 String& String::operator+=(const Char& ch)
 {
-  Data += ch.Str();
-  return *this;
+  return Append(ch.data(), ch.size(), ch.empty() ? 0 : 1);
 }
 
 String& String::operator+=(const std::string& str)
 {
   ASSERT_VALID_UTF8(str);
-
-  Data += str;
-  return *this;
+  return Append(str);
 }
 
 String& String::operator+=(const char* ptr)
 {
   ASSERT_VALID_UTF8(ptr);
+  return Append(ptr, strlen(ptr));
+}
+
+String& String::Append(const std::string& utf8)
+{
+  return Append(utf8.c_str(), utf8.size());
+}
+
+String& String::Append(const char* utf8, size_t size)
+{
+  return Append(utf8, size, CountChars(utf8, size));
+}
 
-  Data += ptr;
+String& String::Append(const char* utf8, size_t size, size_t len)
+{
+  size_t start = Len;
+
+  Data.append(utf8, size);
+  Len += len;
+
+  PatchIndex(start);
   return *this;
 }
 
-String String::operator+(const String& str) const
+String String::Concat(const char* utf8, size_t size, size_t len) const
+{
+  String result;
+  result.Data.reserve(Data.size() + size);
+  result.Data.append(Data).append(utf8, size);
+  result.Len = Len + len;
+  return result;
+}
+
+String String::operator+(const String& str) const&
 {
-  std::string data = Data + str.ToUtf8();
-  return String(Utf8Ptr(data));
+  return Concat(str.Data.c_str(), str.Data.size(), str.Len);
 }
 
-String String::operator+(const AnsiPtr& ptr) const
+String String::operator+(const AnsiPtr& ptr) const&
 {
-  std::string data = Data + AnsiToUtf8(ptr);
-  return String(Utf8Ptr(data));
+  std::string data = AnsiToUtf8(ptr);
+  return Concat(data.c_str(), data.size(), CountChars(data));
 }
 
-String String::operator+(const Utf8Ptr& ptr) const
+String String::operator+(const Utf8Ptr& ptr) const&
 {
-  std::string data = Data + *ptr;
-  return String(Utf8Ptr(data));
+  size_t size = strlen(ptr);
+  return Concat(ptr, size, CountChars(ptr, size));
 }
 
-String String::operator+(const w16string& str) const
+String String::operator+(const w16string& str) const&
 {
-  std::string data = Data + Utf16ToUtf8(str.c_str());
-  return String(Utf8Ptr(data));
+  std::string data = Utf16ToUtf8(str.c_str());
+  return Concat(data.c_str(), data.size(), CountChars(data));
 }
 
-String String::operator+(const w16_type* ptr) const
+String String::operator+(const w16_type* ptr) const&
 {
-  std::string data = Data + Utf16ToUtf8(ptr);
-  return String(Utf8Ptr(data));
+  std::string data = Utf16ToUtf8(ptr);
+  return Concat(data.c_str(), data.size(), CountChars(data));
 }
 
-String String::operator+(const w32string& str) const
+String String::operator+(const w32string& str) const&
 {
-  std::string data = Data + Utf32ToUtf8(str.c_str());
-  return String(Utf8Ptr(data));
+  std::string data = Utf32ToUtf8(str.c_str(), str.size());
+  return Concat(data.c_str(), data.size(), CountChars(data));
 }
 
-String String::operator+(const w32_type* ptr) const
+String String::operator+(const w32_type* ptr) const&
 {
-  std::string data = Data + Utf32ToUtf8(ptr);
-  return String(Utf8Ptr(data));
+  std::string data = Utf32ToUtf8(ptr);
+  return Concat(data.c_str(), data.size(), CountChars(data));
 }
 
-String String::operator+(const Char& ch) const
+String String::operator+(const Char& ch) const&
 {
-  std::string data = Data + ch.Str();
-  return String(Utf8Ptr(data));
+  return Concat(ch.data(), ch.size(), ch.empty() ? 0 : 1);
 }
 
-String String::operator+(char ch) const
+String String::operator+(char ch) const&
 {
   return *this + Char(ch);
 }
 
-String String::operator+(const std::string& str) const
+String String::operator+(const std::string& str) const&
 {
-  return Data + str;
+  ASSERT_VALID_UTF8(str);
+  return Concat(str.c_str(), str.size(), CountChars(str));
 }
 
-String String::operator+(const char* ptr) const
+String String::operator+(const char* ptr) const&
 {
-  return Data + ptr;
+  ASSERT_VALID_UTF8(ptr);
+
+  size_t size = strlen(ptr);
+  return Concat(ptr, size, CountChars(ptr, size));
+}
+
+String String::operator+(const String& str) &&
+{
+  return std::move(*this += str);
+}
+
+String String::operator+(const AnsiPtr& ptr) &&
+{
+  return std::move(*this += ptr);
+}
+
+String String::operator+(const Utf8Ptr& ptr) &&
+{
+  return std::move(*this += ptr);
+}
+
+String String::operator+(const w16string& str) &&
+{
+  return std::move(*this += str);
+}
+
+String String::operator+(const w16_type* ptr) &&
+{
+  return std::move(*this += ptr);
+}
+
+String String::operator+(const w32string& str) &&
+{
+  return std::move(*this += str);
+}
+
+String String::operator+(const w32_type* ptr) &&
+{
+  return std::move(*this += ptr);
+}
+
+String String::operator+(const Char& ch) &&
+{
+  return std::move(*this += ch);
+}
+
+String String::operator+(char ch) &&
+{
+  return std::move(*this += Char(ch));
+}
+
+String String::operator+(const std::string& str) &&
+{
+  return std::move(*this += str);
+}
+
+String String::operator+(const char* ptr) &&
+{
+  return std::move(*this += ptr);
 }
 
 bool String::operator<(const String& str) const
@@ -1413,7 +1934,7 @@ bool String::operator<(const std::string& str) const
 
 bool String::Valid(const std::string& str)
 {
-  return Valid(str.c_str());
+  return Verify(str.c_str(), str.size()) == nullptr;
 }
 
 bool String::Valid(const char* ptr)
@@ -1421,70 +1942,43 @@ bool String::Valid(const char* ptr)
   return Verify(ptr) == nullptr;
 }
 
+bool String::Valid(const char* ptr, size_t size)
+{
+  return Verify(ptr, size) == nullptr;
+}
+
 const char* String::Verify(const char* ptr)
 {
-  unsigned char* s = (unsigned char*)ptr;
+  return simd::Verify(ptr, strlen(ptr));
+}
 
-  while (*s) 
-  {
-    if (*s < 0x80)
-    {
-      s++; // 0xxxxxxx
-      continue;
-    }
+const char* String::Verify(const char* ptr, size_t size)
+{
+  return simd::Verify(ptr, size);
+}
 
-    if ((s[0] & 0xe0) == 0xc0) 
-    {
-      // 110XXXXx 10xxxxxx
-      if ((s[1] & 0xc0) != 0x80 || (s[0] & 0xfe) == 0xc0) // overlong?
-        return (const char*)s;
-      
-      s += 2;
-      continue;
-    }
-    
-    if ((s[0] & 0xf0) == 0xe0) 
-    {
-      // 1110XXXX 10Xxxxxx 10xxxxxx
-      if ((s[1] & 0xc0) != 0x80 ||
-          (s[2] & 0xc0) != 0x80 ||
-          (s[0] == 0xe0 && (s[1] & 0xe0) == 0x80) ||              // overlong?
-          (s[0] == 0xed && (s[1] & 0xe0) == 0xa0) ||              // surrogate?
-          (s[0] == 0xef && s[1] == 0xbf && (s[2] & 0xfe) == 0xbe) // U+FFFE or U+FFFF?
-      )                      
-      {
-        return (const char*)s;
-      }
-      s += 3;
-      continue;
-    } 
-    
-    if ((s[0] & 0xf8) == 0xf0) 
-    {
-      // 11110XXX 10XXxxxx 10xxxxxx 10xxxxxx
-      if ((s[1] & 0xc0) != 0x80 ||
-          (s[2] & 0xc0) != 0x80 ||
-          (s[3] & 0xc0) != 0x80 ||
-          (s[0] == 0xf0 && (s[1] & 0xf0) == 0x80) ||    // overlong?
-          (s[0] == 0xf4 && s[1] > 0x8f) || s[0] > 0xf4   // > U+10FFFF?
-      )
-      {
-        return (const char*)s;
-      }
-      s += 4;
-      continue;
-    } 
-    return (const char*)s;
-  }
-  return nullptr;
+size_t utf8::Utf8Length(const char* ptr, size_t size)
+{
+  return simd::CountChars(ptr, size);
 }
 
-String operator+(const char* left, const String& str) 
-{ 
-  return String(left) + str; 
+String String::Concat(const char* left, size_t size, const String& str)
+{
+  String result;
+  result.Data.reserve(size + str.Data.size());
+  result.Data.append(left, size).append(str.Data);
+  result.Len = CountChars(left, size) + str.Len;
+  return result;
 }
 
-String operator+(const std::string & left, const String& str)
+String utf8::operator+(const char* left, const String& str)
 {
-  return String(left) + str;
-}
\ No newline at end of file
+  ASSERT_VALID_UTF8(left);
+  return String::Concat(left, strlen(left), str);
+}
+
+String utf8::operator+(const std::string& left, const String& str)
+{
+  ASSERT_VALID_UTF8(left);
+  return String::Concat(left.c_str(), left.size(), str);
+}
@@ -0,0 +1,155 @@
+#include <cstring>
+
+#include <utf8/String.h>
+#include <utf8/StringBuilder.h>
+
+#include "Simd.h"
+#include "Transcode.h"
+
+using namespace utf8;
+
+StringBuilder::StringBuilder()
+  : Len(0)
+{
+}
+
+StringBuilder::StringBuilder(size_t bytes)
+  : Len(0)
+{
+  Data.reserve(bytes);
+}
+
+void StringBuilder::Reserve(size_t bytes)
+{
+  Data.reserve(Data.size() + bytes);
+}
+
+bool StringBuilder::Empty() const
+{
+  return Data.empty();
+}
+
+size_t StringBuilder::Length() const
+{
+  return Len;
+}
+
+size_t StringBuilder::Size() const
+{
+  return Data.size();
+}
+
+StringBuilder& StringBuilder::Append(const String& str)
+{
+  Data.append(str.c_str(), str.Size());
+  Len += str.Length();
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(const StringView& utf8)
+{
+  Data.append(utf8.data(), utf8.Size());
+  Len += utf8.Length();
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(const std::string& utf8)
+{
+  return Append(StringView(utf8));
+}
+
+StringBuilder& StringBuilder::Append(const char* utf8)
+{
+  return Append(StringView(utf8));
+}
+
+StringBuilder& StringBuilder::Append(const Char& ch)
+{
+  Data.append(ch.data(), ch.size());
+  Len += ch.empty() ? 0 : 1;
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(const AnsiPtr& ptr)
+{
+#ifdef _WIN32
+  return Append(AnsiToUtf8(ptr));
+#else
+  const char* p = ptr;
+  size_t size = strlen(p);
+
+  while (size)
+  {
+    size_t ascii = simd::AsciiPrefix(p, size);
+    Data.append(p, ascii);
+    Len += ascii;
+    p += ascii;
+    size -= ascii;
+
+    // Same table as Char(char)
+    for (; size && (unsigned char)*p >= 0x80; ++p, --size)
+      Append(Char(*p));
+  }
+
+  return *this;
+#endif
+}
+
+StringBuilder& StringBuilder::Append(const w16string& str)
+{
+  return Append(str.c_str(), str.size());
+}
+
+StringBuilder& StringBuilder::Append(const w16_type* ptr, size_t n)
+{
+  if (n == size_t(-1))
+    n = w16_strlen(ptr);
+
+  size_t size = transcode::Utf16ToUtf8Size(ptr, n);
+  if (size == transcode::npos || size == 0)
+    return *this;
+
+  size_t start = Data.size();
+  Data.resize(start + size);
+
+  Len += transcode::Utf16ToUtf8(ptr, n, &Data[start]);
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(const w32string& str)
+{
+  return Append(str.c_str(), str.size());
+}
+
+StringBuilder& StringBuilder::Append(const w32_type* ptr, size_t n)
+{
+  if (n == size_t(-1))
+    n = w32_strlen(ptr);
+
+  size_t size = transcode::Utf32ToUtf8Size(ptr, n);
+  if (size == transcode::npos || size == 0)
+    return *this;
+
+  size_t start = Data.size();
+  Data.resize(start + size);
+  transcode::Utf32ToUtf8(ptr, n, &Data[start]);
+
+  Len += n;
+  return *this;
+}
+
+String StringBuilder::Build()
+{
+  String str;
+  str.Data.swap(Data);
+  str.Len = Len;
+
+  Clear();
+  return str;
+}
+
+void StringBuilder::Clear()
+{
+  Data.clear();
+  Len = 0;
+}
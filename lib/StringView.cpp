@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstring>
+
+#include <utf8/String.h>
+#include <utf8/StringView.h>
+
+#include "Simd.h"
+
+using namespace utf8;
+
+static const char* FindBytes(const char* p, const char* end, const char* str, size_t size)
+{
+  if (size == 0)
+    return p;
+
+  for (; size_t(end - p) >= size; ++p)
+  {
+    p = (const char*)memchr(p, str[0], end - p - size + 1);
+    if (p == nullptr)
+      break;
+
+    if (memcmp(p, str, size) == 0)
+      return p;
+  }
+  return nullptr;
+}
+
+const size_t StringView::npos;
+
+StringView::StringView()
+  : Ptr("")
+  , Bytes(0)
+  , Len(0)
+{
+}
+
+StringView::StringView(const char* utf8)
+  : Ptr(utf8)
+  , Bytes(strlen(utf8))
+  , Len(npos)
+{
+}
+
+StringView::StringView(const char* utf8, size_t size, size_t len)
+  : Ptr(utf8)
+  , Bytes(size)
+  , Len(len)
+{
+}
+
+StringView::StringView(const std::string& utf8)
+  : Ptr(utf8.c_str())
+  , Bytes(utf8.size())
+  , Len(npos)
+{
+}
+
+StringView::StringView(const String& str)
+  : Ptr(str.c_str())
+  , Bytes(str.Size())
+  , Len(str.Length())
+{
+}
+
+std::string StringView::Str() const
+{
+  return std::string(Ptr, Bytes);
+}
+
+bool StringView::Empty() const
+{
+  return Bytes == 0;
+}
+
+size_t StringView::Length() const
+{
+  return Len != npos ? Len : Utf8Length(Ptr, Bytes);
+}
+
+size_t StringView::Size() const
+{
+  return Bytes;
+}
+
+StringView StringView::Substr(size_t pos, size_t count) const
+{
+  const char* end = Ptr + Bytes;
+  const char* p0 = simd::SkipChars(Ptr, end, pos);
+  const char* p1 = simd::SkipChars(p0, end, count);
+
+  size_t len = npos;
+  if (Len == Bytes)
+    len = p1 - p0;  // ASCII only
+
+  return StringView(p0, p1 - p0, len);
+}
+
+SplitRange StringView::Split(const CodePointSet& delimiters) const
+{
+  return SplitRange(Ptr, Bytes, delimiters);
+}
+
+bool StringView::StartsWith(const StringView& str) const
+{
+  return str.Bytes <= Bytes && memcmp(Ptr, str.Ptr, str.Bytes) == 0;
+}
+
+bool StringView::EndsWith(const StringView& str) const
+{
+  return str.Bytes <= Bytes && memcmp(Ptr + Bytes - str.Bytes, str.Ptr, str.Bytes) == 0;
+}
+
+bool StringView::Includes(const StringView& str, size_t pos) const
+{
+  const char* end = Ptr + Bytes;
+  const char* p0 = simd::SkipChars(Ptr, end, pos);
+  if (p0 == end)
+    return false;
+
+  return FindBytes(p0, end, str.Ptr, str.Bytes) != nullptr;
+}
+
+size_t StringView::IndexOf(const StringView& str, size_t Off) const
+{
+  const char* end = Ptr + Bytes;
+  const char* p0 = simd::SkipChars(Ptr, end, Off);
+
+  const char* p = FindBytes(p0, end, str.Ptr, str.Bytes);
+  if (p == nullptr || p == end)
+    return npos;
+
+  return Off + Utf8Length(p0, p - p0);
+}
+
+size_t StringView::LastIndexOf(const StringView& str) const
+{
+  if (str.Bytes == 0 || str.Bytes > Bytes)
+    return npos;
+
+  for (const char* p = Ptr + Bytes - str.Bytes;; --p)
+  {
+    if (memcmp(p, str.Ptr, str.Bytes) == 0)
+      return Utf8Length(Ptr, p - Ptr);
+
+    if (p == Ptr)
+      break;
+  }
+  return npos;
+}
+
+bool StringView::operator==(const StringView& str) const
+{
+  return Bytes == str.Bytes && memcmp(Ptr, str.Ptr, Bytes) == 0;
+}
+
+bool StringView::operator!=(const StringView& str) const
+{
+  return !operator==(str);
+}
+
+bool StringView::operator<(const StringView& str) const
+{
+  int r = memcmp(Ptr, str.Ptr, std::min(Bytes, str.Bytes));
+  return r < 0 || (r == 0 && Bytes < str.Bytes);
+}
@@ -0,0 +1,384 @@
+#include "Simd.h"
+#include "Transcode.h"
+
+#ifdef UTF8_SSE2
+  #include <immintrin.h>
+#endif
+
+using namespace utf8;
+
+typedef const unsigned char* bytes_t;
+
+// Decodes one multibyte sequence starting at s (*s >= 0x80). Overlongs,
+// surrogates and values above U+10FFFF are rejected
+static inline bool DecodeMultibyte(bytes_t& s, bytes_t end, uint32_t& cp)
+{
+  unsigned char b0 = s[0];
+  size_t left = size_t(end - s);
+
+  if (b0 >= 0xc2 && b0 <= 0xdf)
+  {
+    if (left < 2 || (s[1] & 0xc0) != 0x80)
+      return false;
+
+    cp = (uint32_t(b0 & 0x1f) << 6) | (s[1] & 0x3f);
+    s += 2;
+    return true;
+  }
+
+  if ((b0 & 0xf0) == 0xe0)
+  {
+    if (left < 3 || (s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80)
+      return false;
+
+    cp = (uint32_t(b0 & 0x0f) << 12) | (uint32_t(s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+    if (cp < 0x800 || (cp >= 0xd800 && cp <= 0xdfff))
+      return false;
+
+    s += 3;
+    return true;
+  }
+
+  if (b0 >= 0xf0 && b0 <= 0xf4)
+  {
+    if (left < 4 || (s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80 || (s[3] & 0xc0) != 0x80)
+      return false;
+
+    cp = (uint32_t(b0 & 0x07) << 18) | (uint32_t(s[1] & 0x3f) << 12)
+      | (uint32_t(s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+    if (cp < 0x10000 || cp > 0x10ffff)
+      return false;
+
+    s += 4;
+    return true;
+  }
+
+  return false;
+}
+
+size_t transcode::Utf8ToUtf16(const char* ptr, size_t size, w16_type* out)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+  w16_type* p = out;
+
+  while (s < end)
+  {
+    if (*s < 0x80)
+    {
+#ifdef UTF8_SSE2
+      // Widen blocks of 16 ASCII characters at once
+      for (; end - s >= 16; s += 16, p += 16)
+      {
+        __m128i in = _mm_loadu_si128((const __m128i*)s);
+        if (_mm_movemask_epi8(in))
+          break;
+
+        __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128((__m128i*)p, _mm_unpacklo_epi8(in, zero));
+        _mm_storeu_si128((__m128i*)(p + 8), _mm_unpackhi_epi8(in, zero));
+      }
+#endif
+      while (s < end && *s < 0x80)
+        *p++ = w16_type(*s++);
+
+      continue;
+    }
+
+    uint32_t cp;
+    if (!DecodeMultibyte(s, end, cp))
+      return npos;
+
+    if (cp < 0x10000)
+    {
+      *p++ = w16_type(cp);
+    }
+    else
+    {
+      cp -= 0x10000;
+      *p++ = w16_type(0xd800 + (cp >> 10));
+      *p++ = w16_type(0xdc00 + (cp & 0x3ff));
+    }
+  }
+
+  return size_t(p - out);
+}
+
+#ifdef UTF8_SSE2
+// Widens a block of 16 ASCII characters, returns false if the block has
+// other characters
+static inline bool AsciiBlockToUtf32(bytes_t s, w32_type* p)
+{
+  __m128i in = _mm_loadu_si128((const __m128i*)s);
+  if (_mm_movemask_epi8(in))
+    return false;
+
+  __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_unpacklo_epi8(in, zero);
+  __m128i hi = _mm_unpackhi_epi8(in, zero);
+
+  _mm_storeu_si128((__m128i*)p, _mm_unpacklo_epi16(lo, zero));
+  _mm_storeu_si128((__m128i*)(p + 4), _mm_unpackhi_epi16(lo, zero));
+  _mm_storeu_si128((__m128i*)(p + 8), _mm_unpacklo_epi16(hi, zero));
+  _mm_storeu_si128((__m128i*)(p + 12), _mm_unpackhi_epi16(hi, zero));
+  return true;
+}
+
+// Decodes 8 two byte sequences (Latin, Greek, Cyrillic, ...) at once,
+// returns false if the block is anything else
+static inline bool TwoByteBlockToUtf32(bytes_t s, w32_type* p)
+{
+  __m128i in = _mm_loadu_si128((const __m128i*)s);
+
+  // Little endian 16-bit lanes: lead byte 110xxxxx low, 10xxxxxx high
+  __m128i shape = _mm_cmpeq_epi16(
+    _mm_and_si128(in, _mm_set1_epi16(short(0xc0e0)))
+    , _mm_set1_epi16(short(0x80c0))
+  );
+
+  // C0 and C1 leads are overlong
+  __m128i overlong = _mm_cmpeq_epi16(
+    _mm_and_si128(in, _mm_set1_epi16(0x1e))
+    , _mm_setzero_si128()
+  );
+
+  if (_mm_movemask_epi8(_mm_andnot_si128(overlong, shape)) != 0xffff)
+    return false;
+
+  __m128i cp = _mm_or_si128(
+    _mm_slli_epi16(_mm_and_si128(in, _mm_set1_epi16(0x1f)), 6)
+    , _mm_and_si128(_mm_srli_epi16(in, 8), _mm_set1_epi16(0x3f))
+  );
+
+  __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128((__m128i*)p, _mm_unpacklo_epi16(cp, zero));
+  _mm_storeu_si128((__m128i*)(p + 4), _mm_unpackhi_epi16(cp, zero));
+  return true;
+}
+#endif
+
+size_t transcode::Utf8ToUtf32(const char* ptr, size_t size, w32_type* out)
+{
+  bytes_t s = (bytes_t)ptr;
+  bytes_t end = s + size;
+  w32_type* p = out;
+
+  while (s < end)
+  {
+    if (*s < 0x80)
+    {
+#ifdef UTF8_SSE2
+      for (; end - s >= 16 && AsciiBlockToUtf32(s, p); s += 16, p += 16)
+        ;
+#endif
+      while (s < end && *s < 0x80)
+        *p++ = w32_type(*s++);
+
+      continue;
+    }
+
+#ifdef UTF8_SSE2
+    if (end - s >= 16 && TwoByteBlockToUtf32(s, p))
+    {
+      s += 16;
+      p += 8;
+      continue;
+    }
+#endif
+
+    uint32_t cp;
+    if (!DecodeMultibyte(s, end, cp))
+      return npos;
+
+    *p++ = w32_type(cp);
+  }
+
+  return size_t(p - out);
+}
+
+size_t transcode::Utf32ToUtf8Size(const w32_type* ptr, size_t n)
+{
+  size_t size = 0;
+  size_t i = 0;
+
+#ifdef UTF8_SSE2
+  __m128i total = _mm_setzero_si128();
+  __m128i error = _mm_setzero_si128();
+
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128i cp = _mm_loadu_si128((const __m128i*)(ptr + i));
+
+    // 1 byte + 1 for each of the 0x7F/0x7FF/0xFFFF limits exceeded
+    // (compare results are -1)
+    total = _mm_sub_epi32(total, _mm_cmpgt_epi32(cp, _mm_set1_epi32(0x7f)));
+    total = _mm_sub_epi32(total, _mm_cmpgt_epi32(cp, _mm_set1_epi32(0x7ff)));
+    total = _mm_sub_epi32(total, _mm_cmpgt_epi32(cp, _mm_set1_epi32(0xffff)));
+
+    __m128i surrogate = _mm_and_si128(
+      _mm_cmpgt_epi32(cp, _mm_set1_epi32(0xd7ff))
+      , _mm_cmplt_epi32(cp, _mm_set1_epi32(0xe000))
+    );
+
+    error = _mm_or_si128(error, surrogate);
+    error = _mm_or_si128(error, _mm_cmpgt_epi32(cp, _mm_set1_epi32(0x10ffff)));
+    error = _mm_or_si128(error, _mm_cmplt_epi32(cp, _mm_setzero_si128()));
+  }
+
+  if (_mm_movemask_epi8(error))
+    return npos;
+
+  uint32_t lanes[4];
+  _mm_storeu_si128((__m128i*)lanes, total);
+  size = i + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; i < n; ++i)
+  {
+    uint32_t cp = uint32_t(ptr[i]);
+    if ((cp >= 0xd800 && cp <= 0xdfff) || cp > 0x10ffff)
+      return npos;
+
+    size += 1 + (cp >= 0x80) + (cp >= 0x800) + (cp >= 0x10000);
+  }
+
+  return size;
+}
+
+#ifdef UTF8_SSE2
+// Narrows 16 ASCII code points to 16 bytes
+static inline bool AsciiBlockToUtf8(const w32_type* ptr, unsigned char* p)
+{
+  __m128i a = _mm_loadu_si128((const __m128i*)ptr);
+  __m128i b = _mm_loadu_si128((const __m128i*)(ptr + 4));
+  __m128i c = _mm_loadu_si128((const __m128i*)(ptr + 8));
+  __m128i d = _mm_loadu_si128((const __m128i*)(ptr + 12));
+
+  // Valid code points are non-negative, so OR of all lanes <= 0x7F means
+  // that every lane is
+  __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+  if (_mm_movemask_epi8(_mm_cmpgt_epi32(any, _mm_set1_epi32(0x7f))))
+    return false;
+
+  __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+  _mm_storeu_si128((__m128i*)p, bytes);
+  return true;
+}
+
+// Encodes 8 code points of U+0080..U+07FF as 8 two byte sequences
+static inline bool TwoByteBlockToUtf8(const w32_type* ptr, unsigned char* p)
+{
+  __m128i a = _mm_loadu_si128((const __m128i*)ptr);
+  __m128i b = _mm_loadu_si128((const __m128i*)(ptr + 4));
+
+  __m128i lower = _mm_set1_epi32(0x7f);
+  __m128i upper = _mm_set1_epi32(0x800);
+  __m128i inRange = _mm_and_si128(
+    _mm_and_si128(_mm_cmpgt_epi32(a, lower), _mm_cmplt_epi32(a, upper))
+    , _mm_and_si128(_mm_cmpgt_epi32(b, lower), _mm_cmplt_epi32(b, upper))
+  );
+
+  if (_mm_movemask_epi8(inRange) != 0xffff)
+    return false;
+
+  // Little endian 16-bit lanes: 110xxxxx lead low, 10xxxxxx high
+  __m128i cp = _mm_packs_epi32(a, b);
+  __m128i lead = _mm_or_si128(_mm_srli_epi16(cp, 6), _mm_set1_epi16(0xc0));
+  __m128i cont = _mm_or_si128(_mm_and_si128(cp, _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+
+  _mm_storeu_si128((__m128i*)p, _mm_or_si128(lead, _mm_slli_epi16(cont, 8)));
+  return true;
+}
+#endif
+
+size_t transcode::Utf32ToUtf8(const w32_type* ptr, size_t n, char* out)
+{
+  const w32_type* end = ptr + n;
+  unsigned char* p = (unsigned char*)out;
+
+  while (ptr < end)
+  {
+#ifdef UTF8_SSE2
+    if (end - ptr >= 16 && AsciiBlockToUtf8(ptr, p))
+    {
+      ptr += 16;
+      p += 16;
+      continue;
+    }
+
+    if (end - ptr >= 8 && TwoByteBlockToUtf8(ptr, p))
+    {
+      ptr += 8;
+      p += 16;
+      continue;
+    }
+
+    // Mixed block, encode a few code points before trying again
+    for (const w32_type* stop = ptr + (end - ptr < 8 ? end - ptr : 8); ptr < stop;)
+      p = EncodeUtf8(uint32_t(*ptr++), p);
+#else
+    p = EncodeUtf8(uint32_t(*ptr++), p);
+#endif
+  }
+
+  return size_t(p - (unsigned char*)out);
+}
+
+size_t transcode::Utf16ToUtf8Size(const w16_type* ptr, size_t n)
+{
+  const w16_type* end = ptr + n;
+  size_t size = 0;
+
+  while (ptr < end)
+  {
+    uint32_t cu = uint32_t(*ptr++);
+    if (cu >= 0xd800 && cu <= 0xdfff)
+    {
+      if (cu >= 0xdc00 || ptr == end || *ptr < 0xdc00 || *ptr > 0xdfff)
+        return npos;
+
+      ++ptr;
+      size += 4;
+    }
+    else
+      size += 1 + (cu >= 0x80) + (cu >= 0x800);
+  }
+
+  return size;
+}
+
+size_t transcode::Utf16ToUtf8(const w16_type* ptr, size_t n, char* out)
+{
+  const w16_type* end = ptr + n;
+  unsigned char* p = (unsigned char*)out;
+  size_t pairs = 0;
+
+  while (ptr < end)
+  {
+#ifdef UTF8_SSE2
+    // Narrow blocks of 8 ASCII code units at once
+    for (; end - ptr >= 8; ptr += 8, p += 8)
+    {
+      __m128i in = _mm_loadu_si128((const __m128i*)ptr);
+      __m128i high = _mm_and_si128(in, _mm_set1_epi16(short(0xff80)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xffff)
+        break;
+
+      _mm_storel_epi64((__m128i*)p, _mm_packus_epi16(in, in));
+    }
+
+    if (ptr == end)
+      break;
+#endif
+    uint32_t cp = uint32_t(*ptr++);
+    if (cp >= 0xd800 && cp <= 0xdfff)
+    {
+      cp = 0x10000 + ((cp - 0xd800) << 10) + (uint32_t(*ptr++) - 0xdc00);
+      ++pairs;
+    }
+
+    p = EncodeUtf8(cp, p);
+  }
+
+  return n - pairs;
+}
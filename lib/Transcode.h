@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+#include <utf8/Convert.h>
+
+// Built-in transcoders used instead of iconv on Posix systems. They write
+// into caller allocated buffers and return the number of code units written
+// or npos when the input is not well-formed
+
+namespace utf8
+{
+  namespace transcode
+  {
+    const size_t npos = size_t(-1);
+
+    // Writes the UTF-8 sequence of a valid code point cp to p and returns
+    // the end of it
+    inline unsigned char* EncodeUtf8(uint32_t cp, unsigned char* p)
+    {
+      if (cp < 0x80)
+      {
+        *p++ = (unsigned char)cp;
+      }
+      else if (cp < 0x800)
+      {
+        *p++ = (unsigned char)(0xc0 | (cp >> 6));
+        *p++ = (unsigned char)(0x80 | (cp & 0x3f));
+      }
+      else if (cp < 0x10000)
+      {
+        *p++ = (unsigned char)(0xe0 | (cp >> 12));
+        *p++ = (unsigned char)(0x80 | ((cp >> 6) & 0x3f));
+        *p++ = (unsigned char)(0x80 | (cp & 0x3f));
+      }
+      else
+      {
+        *p++ = (unsigned char)(0xf0 | (cp >> 18));
+        *p++ = (unsigned char)(0x80 | ((cp >> 12) & 0x3f));
+        *p++ = (unsigned char)(0x80 | ((cp >> 6) & 0x3f));
+        *p++ = (unsigned char)(0x80 | (cp & 0x3f));
+      }
+      return p;
+    }
+
+    // out must have room for size code units
+    size_t Utf8ToUtf16(const char* ptr, size_t size, w16_type* out);
+    size_t Utf8ToUtf32(const char* ptr, size_t size, w32_type* out);
+
+    // Exact UTF-8 size of n code points or npos if there are surrogates
+    // or values above U+10FFFF. Utf32ToUtf8 expects input accepted by
+    // Utf32ToUtf8Size and an out buffer of that size
+    size_t Utf32ToUtf8Size(const w32_type* ptr, size_t n);
+    size_t Utf32ToUtf8(const w32_type* ptr, size_t n, char* out);
+
+    // Exact UTF-8 size of n code units or npos if there are unpaired
+    // surrogates. Utf16ToUtf8 expects input accepted by Utf16ToUtf8Size and
+    // an out buffer of that size, it returns the number of code points
+    size_t Utf16ToUtf8Size(const w16_type* ptr, size_t n);
+    size_t Utf16ToUtf8(const w16_type* ptr, size_t n, char* out);
+  }
+}
@@ -1,22 +1,59 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <set>
 #include <string>
-#include <vector>
 
 namespace utf8
 {
-  struct Char : public std::vector<char>
+  // Single UTF-8 encoded character. Up to 4 bytes are stored inline, so
+  // Char is trivially copyable and never allocates
+  struct Char
   {
     Char();
-    Char(const Char& ch);       // UTF-8
     Char(char ch);              // ANSI / LATIN
     Char(wchar_t ch);           // Windows: UTF-16, Posix: UTF-32
     Char(char16_t ch);          // UTF-16
     Char(char32_t ch);          // UTF-32
 
+    // count bytes b0.. of an already encoded character. Not validated, used
+    // to build compile time constants (see utf8/Literals.h)
+    constexpr Char(char b0, char b1, char b2, char b3, unsigned char count)
+      : Bytes{ b0, b1, b2, b3 }
+      , Count(count)
+    {
+    }
+
     std::string Str() const;
 
+    // UTF-8 bytes of the character
+    constexpr size_t size() const { return Count; }
+    constexpr bool empty() const { return Count == 0; }
+    constexpr const char* data() const { return Bytes; }
+    constexpr const char* begin() const { return Bytes; }
+    constexpr const char* end() const { return Bytes + Count; }
+    constexpr char operator[](size_t i) const { return Bytes[i]; }
+
+    // A character has at most 4 bytes. Debug builds assert on a fifth one,
+    // release builds drop it
+    void push_back(char ch)
+    {
+      assert(Count < sizeof(Bytes));
+      if (Count < sizeof(Bytes))
+        Bytes[Count++] = ch;
+    }
+
+    void clear() { Count = 0; }
+    void reserve(size_t) {}
+
+    // Bytes packed big endian followed by the byte count. Keys of valid
+    // characters compare in code point order
+    uint64_t Key() const;
+
     bool operator==(const Char& ch) const;
     bool operator==(char ch) const;
     bool operator==(wchar_t ch) const;
@@ -29,9 +66,27 @@ namespace utf8
     bool operator!=(char16_t ch) const;
     bool operator!=(char32_t ch) const;
 
-  protected:
-    void AppendString(const std::string& str);
+    bool operator<(const Char& ch) const;
+
+  private:
+    void Encode(uint32_t cp);
+
+    char Bytes[4];
+    unsigned char Count;
   };
 
   typedef std::set<Char> CharSet;
+  typedef std::map<Char, Char> CharMap;
+}
+
+namespace std
+{
+  template<>
+  struct hash<utf8::Char>
+  {
+    size_t operator()(const utf8::Char& ch) const
+    {
+      return hash<uint64_t>()(ch.Key());
+    }
+  };
 }
\ No newline at end of file
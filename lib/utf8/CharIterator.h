@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <utf8/Char.h>
+
+namespace utf8
+{
+  // Bidirectional iterator over the code points of valid UTF-8 text.
+  // Dereferencing decodes the character at the current position, stepping
+  // looks at the lead byte (forward) or skips continuation bytes (back)
+  class CharIterator
+  {
+    const char* Ptr;
+
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef char32_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const char32_t* pointer;
+    typedef char32_t reference;
+
+    CharIterator() : Ptr(nullptr) {}
+    explicit CharIterator(const char* p) : Ptr(p) {}
+
+    // Position in the UTF-8 text and size of the current character
+    const char* Position() const { return Ptr; }
+    size_t Size() const { return SizeOf((unsigned char)*Ptr); }
+
+    char32_t operator*() const
+    {
+      const unsigned char* s = (const unsigned char*)Ptr;
+      switch (SizeOf(s[0]))
+      {
+      case 2:
+        return char32_t(((s[0] & 0x1F) << 6) | (s[1] & 0x3F));
+      case 3:
+        return char32_t(((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+      case 4:
+        return char32_t(((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F));
+      }
+      return char32_t(s[0]);
+    }
+
+    Char ToChar() const
+    {
+      Char ch;
+      for (size_t i = 0, n = Size(); i < n; ++i)
+        ch.push_back(Ptr[i]);
+      return ch;
+    }
+
+    CharIterator& operator++()
+    {
+      Ptr += SizeOf((unsigned char)*Ptr);
+      return *this;
+    }
+
+    CharIterator& operator--()
+    {
+      do
+        Ptr--;
+      while (((unsigned char)*Ptr & 0xC0) == 0x80);
+      return *this;
+    }
+
+    CharIterator operator++(int) { CharIterator it = *this; ++*this; return it; }
+    CharIterator operator--(int) { CharIterator it = *this; --*this; return it; }
+
+    bool operator==(const CharIterator& it) const { return Ptr == it.Ptr; }
+    bool operator!=(const CharIterator& it) const { return Ptr != it.Ptr; }
+
+  private:
+    static size_t SizeOf(unsigned char lead)
+    {
+      // Continuation and invalid lead bytes step by one byte
+      return lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    }
+  };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <utf8/Char.h>
+
+namespace utf8
+{
+  // Set of ASCII bytes prepared for the vectorized scanners
+  struct ByteSet
+  {
+    uint64_t Bits[2];           // Bit c of Bits[c / 64] is set for members
+    uint8_t Nibbles[16];        // Bit h of Nibbles[l] is set for member (h << 4) | l
+    char Bytes[8];              // First members, compared directly by SSE2
+    size_t Count;               // Number of members
+
+    ByteSet(const uint64_t bits[2]);
+  };
+
+  // Set of code points for Split, Trim and Remove. U+0000..U+007F and
+  // U+0080..U+07FF (Latin, Greek, Cyrillic, Hebrew, Arabic...) are kept in
+  // bitmaps, everything above in a sorted list of ranges
+  class CodePointSet
+  {
+    uint64_t Ascii[2];
+    uint64_t TwoByte[30];
+    std::vector<std::pair<char32_t, char32_t>> Ranges;   // [first, last]
+
+  public:
+    CodePointSet();
+    CodePointSet(const CharSet& chars);
+    CodePointSet(const char* utf8);      // Every character of the string
+
+    void Insert(char32_t cp);
+    void Insert(char32_t first, char32_t last);
+    void Insert(const Char& ch);
+
+    bool Empty() const;
+    bool IsAscii() const;                // Every member is below U+0080
+    const uint64_t* AsciiBits() const { return Ascii; }
+    bool Contains(char32_t cp) const;
+    bool Contains(const Char& ch) const;
+
+    // Membership of the n byte UTF-8 character at p
+    bool Contains(const char* p, size_t n) const
+    {
+      unsigned char c = (unsigned char)p[0];
+      if (c < 0x80)
+        return (Ascii[c >> 6] >> (c & 63)) & 1;
+
+      if (n == 2)
+      {
+        // 0xC0 and 0xC1 start overlong forms of ASCII, which are not members
+        if (c < 0xC2)
+          return false;
+
+        uint32_t i = (((c & 0x1F) << 6) | (p[1] & 0x3F)) - 0x80;
+        return (TwoByte[i >> 6] >> (i & 63)) & 1;
+      }
+
+      return !Ranges.empty() && InRanges(p, n);
+    }
+
+  private:
+    bool InRanges(const char* p, size_t n) const;
+  };
+}
@@ -72,6 +72,7 @@ namespace utf8
   std::string Utf16ToAnsi(const w16_type* ptr);
 
   std::string Utf32ToUtf8(const w32_type* ptr);
+  std::string Utf32ToUtf8(const w32_type* ptr, size_t n);
 
   w16string AnsiToUtf16(const char* ptr);
   w16string Utf8ToUtf16(const char* ptr);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <utf8/StringView.h>
+
+namespace utf8
+{
+  class String;
+
+  // Positional edits applied to a String in one pass. Positions are in
+  // characters and refer to the string before any of the edits:
+  //
+  //   EditBatch edits;
+  //   edits.Remove(0, 2).Insert(10, "x").Replace(20, 1, "y");
+  //   edits.Apply(str);
+  //
+  // Inserts at the same position are applied in the order they were added,
+  // ahead of a removal that starts there. Removed ranges must not overlap
+  // each other or contain an insert
+  class EditBatch
+  {
+    struct Edit
+    {
+      size_t Pos;
+      size_t Count;             // Characters to remove
+      std::string Text;         // UTF-8 text to insert
+      size_t Len;               // Length of Text in characters
+    };
+
+    std::vector<Edit> Edits;
+
+  public:
+    EditBatch& Remove(size_t pos, size_t count = 1);
+    EditBatch& Insert(size_t pos, const StringView& text);
+    EditBatch& Replace(size_t pos, size_t count, const StringView& text);
+
+    size_t Size() const;
+    bool Empty() const;
+    void Clear();
+
+    // Returns false and leaves str unchanged if an edit is out of range or
+    // the edits overlap
+    bool Apply(String& str) const;
+  };
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+// Compile time UTF-8 constants (C++17 and later)
+//
+//   using namespace utf8::literals;
+//
+//   constexpr utf8::Char dash = U'—'_u8c;
+//   constexpr auto name = "王明"_u8s;       // name.Length() == 2
+//
+// Malformed input is rejected at compile time when the literal is used in a
+// constant expression and throws std::invalid_argument otherwise
+
+#include <utf8/Char.h>
+#include <utf8/StringTemplate.h>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+
+#include <stdexcept>
+#include <string>
+
+namespace utf8
+{
+  namespace literals
+  {
+    // Number of UTF-8 bytes of code point cp or 0 for surrogates and values
+    // above U+10FFFF
+    constexpr size_t EncodedSize(char32_t cp)
+    {
+      if (cp < 0x80)
+        return 1;
+      if (cp < 0x800)
+        return 2;
+      if (cp < 0x10000)
+        return cp >= 0xD800 && cp <= 0xDFFF ? 0 : 3;
+      if (cp <= 0x10FFFF)
+        return 4;
+
+      return 0;
+    }
+
+    constexpr Char Encode(char32_t cp)
+    {
+      switch (EncodedSize(cp))
+      {
+      case 1:
+        // Same as Char(U'\0'): NUL is not stored
+        return Char(char(cp), 0, 0, 0, cp ? 1 : 0);
+      case 2:
+        return Char(
+          char(0xC0 | (cp >> 6))
+          , char(0x80 | (cp & 0x3F))
+          , 0
+          , 0
+          , 2
+        );
+      case 3:
+        return Char(
+          char(0xE0 | (cp >> 12))
+          , char(0x80 | ((cp >> 6) & 0x3F))
+          , char(0x80 | (cp & 0x3F))
+          , 0
+          , 3
+        );
+      case 4:
+        return Char(
+          char(0xF0 | (cp >> 18))
+          , char(0x80 | ((cp >> 12) & 0x3F))
+          , char(0x80 | ((cp >> 6) & 0x3F))
+          , char(0x80 | (cp & 0x3F))
+          , 4
+        );
+      }
+
+      throw std::invalid_argument("utf8: invalid code point");
+    }
+
+    // Size of the well-formed sequence at [ptr, ptr + size) or 0. Same rules
+    // as String::Valid: overlongs, surrogates, code points above U+10FFFF
+    // and U+FFFE/U+FFFF are rejected
+    template<typename CharType>
+    constexpr size_t SequenceSize(const CharType* ptr, size_t size)
+    {
+      unsigned char c0 = (unsigned char)ptr[0];
+      if (c0 < 0x80)
+        return 1;
+
+      size_t n = c0 >= 0xF0 ? 4 : c0 >= 0xE0 ? 3 : c0 >= 0xC0 ? 2 : 0;
+      if (n == 0 || n > size)
+        return 0;
+
+      char32_t cp = c0 & (0x7F >> n);
+      for (size_t i = 1; i < n; ++i)
+      {
+        unsigned char c = (unsigned char)ptr[i];
+        if ((c & 0xC0) != 0x80)
+          return 0;
+
+        cp = (cp << 6) | (c & 0x3F);
+      }
+
+      if (EncodedSize(cp) != n || cp == 0xFFFE || cp == 0xFFFF)
+        return 0;
+
+      return n;
+    }
+
+    // Number of characters in [ptr, ptr + size)
+    template<typename CharType>
+    constexpr size_t Validate(const CharType* ptr, size_t size)
+    {
+      size_t len = 0;
+      for (size_t pos = 0; pos < size; ++len)
+      {
+        size_t n = SequenceSize(ptr + pos, size - pos);
+        if (n == 0)
+          throw std::invalid_argument("utf8: malformed string literal");
+
+        pos += n;
+      }
+
+      return len;
+    }
+
+    template<typename CharType>
+    constexpr Char SingleChar(const CharType* ptr, size_t size)
+    {
+      if (size == 0 || SequenceSize(ptr, size) != size)
+        throw std::invalid_argument("utf8: literal is not a single character");
+
+      return Char(
+        char(ptr[0])
+        , char(size > 1 ? ptr[1] : 0)
+        , char(size > 2 ? ptr[2] : 0)
+        , char(size > 3 ? ptr[3] : 0)
+        , (unsigned char)size
+      );
+    }
+
+    // Validated UTF-8 string constant with precomputed size and length.
+    // Refers to the literal storage, which has static duration
+    template<typename CharType>
+    class StringLiteral
+    {
+      const CharType* Ptr;
+      size_t Bytes;
+      size_t Len;
+
+    public:
+      constexpr StringLiteral(const CharType* ptr, size_t size)
+        : Ptr(ptr)
+        , Bytes(size)
+        , Len(Validate(ptr, size))
+      {
+      }
+
+      constexpr const CharType* data() const { return Ptr; }
+      constexpr size_t Size() const { return Bytes; }     // Size in bytes
+      constexpr size_t Length() const { return Len; }     // Length in characters
+      constexpr bool Empty() const { return Bytes == 0; }
+
+      const char* c_str() const { return reinterpret_cast<const char*>(Ptr); }
+      std::string Str() const { return std::string(c_str(), Bytes); }
+
+      bool operator==(const std::string& str) const
+      {
+        return str.size() == Bytes && str.compare(0, Bytes, c_str(), Bytes) == 0;
+      }
+
+      bool operator==(const char* ptr) const
+      {
+        return xstrlen(ptr) == Bytes && std::string::traits_type::compare(ptr, c_str(), Bytes) == 0;
+      }
+
+      bool operator!=(const std::string& str) const { return !operator==(str); }
+      bool operator!=(const char* ptr) const { return !operator==(ptr); }
+    };
+
+    constexpr Char operator""_u8c(char ch)
+    {
+      if ((unsigned char)ch >= 0x80)
+        throw std::invalid_argument("utf8: non-ASCII char literal");
+
+      return Encode(char32_t(ch));
+    }
+
+    constexpr Char operator""_u8c(char16_t ch)
+    {
+      return Encode(ch);
+    }
+
+    constexpr Char operator""_u8c(char32_t ch)
+    {
+      return Encode(ch);
+    }
+
+    constexpr Char operator""_u8c(wchar_t ch)
+    {
+      return Encode(char32_t(ch));
+    }
+
+    constexpr Char operator""_u8c(const char* ptr, size_t size)
+    {
+      return SingleChar(ptr, size);
+    }
+
+    constexpr StringLiteral<char> operator""_u8s(const char* ptr, size_t size)
+    {
+      return StringLiteral<char>(ptr, size);
+    }
+
+#ifdef __cpp_char8_t
+    constexpr Char operator""_u8c(char8_t ch)
+    {
+      return operator""_u8c(char(ch));
+    }
+
+    constexpr Char operator""_u8c(const char8_t* ptr, size_t size)
+    {
+      return SingleChar(ptr, size);
+    }
+
+    constexpr StringLiteral<char8_t> operator""_u8s(const char8_t* ptr, size_t size)
+    {
+      return StringLiteral<char8_t>(ptr, size);
+    }
+#endif
+  }
+}
+
+#endif
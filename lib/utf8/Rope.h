@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <utf8/Char.h>
+#include <utf8/StringView.h>
+
+namespace utf8
+{
+  class String;
+
+  // Mutable UTF-8 text for large documents. The text is kept in chunks of
+  // up to MaxChunk bytes in a balanced tree (treap) whose nodes cache the
+  // byte and character counts of their subtree, so positional access and
+  // edits take O(log n) instead of the O(n) of String. Positions are in
+  // characters
+  class Rope
+  {
+    struct Node;
+    typedef std::unique_ptr<Node> NodePtr;
+
+    NodePtr Root;
+    uint32_t Seed;              // Node priorities
+
+  public:
+    static const size_t MaxChunk = 512;
+
+    Rope();
+    Rope(const StringView& text);
+    Rope(const Rope& rope);
+    Rope(Rope&& rope) noexcept;
+    ~Rope();
+
+    Rope& operator=(const Rope& rope);
+    Rope& operator=(Rope&& rope) noexcept;
+
+    bool Empty() const;
+    size_t Length() const;      // Length in characters
+    size_t Size() const;        // Size in bytes
+
+    Char CharAt(size_t charIndex) const;
+    String Substr(size_t pos = 0, size_t count = std::string::npos) const;
+    String ToString() const;
+
+    // charIndex == Length() or std::string::npos appends. Return false if
+    // charIndex is out of range
+    bool InsertAt(size_t charIndex, const StringView& text);
+    bool RemoveAt(size_t charIndex, size_t count = 1);
+
+    void Append(const StringView& text);
+    void Clear();
+
+  private:
+    NodePtr NewNode(const char* ptr, size_t size, size_t len);
+    NodePtr Build(const char* ptr, size_t size);
+
+    static NodePtr Clone(const Node* node);
+    static void Update(Node* node);
+    static NodePtr Merge(NodePtr left, NodePtr right);
+    void Split(NodePtr node, size_t charIndex, NodePtr& left, NodePtr& right);
+    static bool InsertInChunk(Node* node, size_t charIndex, const char* ptr, size_t size, size_t len);
+    static size_t RemoveInChunk(Node* node, size_t charIndex, size_t count);    // Bytes removed or 0
+
+    // Appends count characters of the subtree starting at charIndex to out
+    static void AppendRange(const Node* node, size_t charIndex, size_t count, std::string& out);
+  };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <iterator>
+#include <string>
+
+#include <utf8/CodePointSet.h>
+#include <utf8/StringView.h>
+
+namespace utf8
+{
+  // Lazy String::Split. Yields StringView tokens into the source text, which
+  // must stay alive and unchanged while the range is used:
+  //
+  //   for (auto& token : str.Tokenize(" ,"))
+  //     ...
+  //
+  // Tokens are the same as Split returns, including empty ones
+  class SplitRange
+  {
+  public:
+    typedef StringView Token;
+
+    class iterator
+    {
+      const SplitRange* Range;
+      const char* Next;         // Start of the next token or nullptr after the last one
+      Token Current;            // Current.data() is nullptr for end()
+
+      friend class SplitRange;
+
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef Token value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const Token* pointer;
+      typedef const Token& reference;
+
+      iterator();
+
+      const Token& operator*() const { return Current; }
+      const Token* operator->() const { return &Current; }
+
+      iterator& operator++();
+      iterator operator++(int);
+
+      bool operator==(const iterator& it) const { return Current.data() == it.Current.data(); }
+      bool operator!=(const iterator& it) const { return Current.data() != it.Current.data(); }
+    };
+
+    typedef iterator const_iterator;
+
+    SplitRange(const char* ptr, size_t size, const CodePointSet& delimiters);
+
+    iterator begin() const;
+    iterator end() const;
+
+  private:
+    const char* Begin;
+    const char* End;
+    CodePointSet Delimiters;
+    bool Ascii;
+    ByteSet Bytes;              // Delimiters and NUL, when Ascii
+
+    void Scan(iterator& it, const char* p) const;
+  };
+}
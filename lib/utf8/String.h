@@ -1,8 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
+
 #include <utf8/Char.h>
+#include <utf8/CharIterator.h>
+#include <utf8/CodePointSet.h>
 #include <utf8/ConstStringPtr.h>
 #include <utf8/Convert.h>
+#include <utf8/EditBatch.h>
+#include <utf8/Rope.h>
+#include <utf8/SplitRange.h>
+#include <utf8/StringBuilder.h>
+#include <utf8/StringView.h>
 
 #ifdef _DEBUG
   #define ASSERT_VALID_UTF8(s)   assert(utf8::String::Valid(s))
@@ -17,7 +27,20 @@ namespace utf8
 
   class String
   {
+    friend class EditBatch;
+    friend class Rope;
+    friend class StringBuilder;
+    friend String operator+(const char* left, const String& str);
+    friend String operator+(const std::string& left, const String& str);
+
     std::string Data;
+    size_t Len;                 // Number of characters in Data
+
+    // Sparse character -> byte offset index. It is built on first positional
+    // access to a long non-ASCII string (thread safe for const access) and
+    // patched or dropped by modifications
+    struct Index;
+    mutable std::atomic<Index*> Positions{nullptr};
 
   public:
     String();
@@ -32,6 +55,8 @@ namespace utf8
     String(const w32_type* ptr, size_t n = -1);
     String(const char* utf8, size_t n = -1);
     String(const std::string& utf8);
+    String(std::string&& utf8);
+    ~String();
 
     // C string pointer / string reference
     const char* c_str() const;
@@ -52,6 +77,15 @@ namespace utf8
     Char operator[](size_t charIndex) const;
     Char LastChar() const;
 
+    // Iteration over characters, dereferences to char32_t
+    typedef CharIterator const_iterator;
+    typedef std::reverse_iterator<CharIterator> const_reverse_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+
     bool RemoveAt(size_t charIndex);
     bool InsertAt(size_t charIndex, const Char& ch);
     bool ReplaceAt(size_t charIndex, const Char& ch);
@@ -72,20 +106,38 @@ namespace utf8
     void TrimLeft(const Char& space = ' ');
     void TrimRight(const Char& space = ' ');
 
+    void Trim(const CodePointSet& spaces);
+    void TrimLeft(const CodePointSet& spaces);
+    void TrimRight(const CodePointSet& spaces);
+
     void Remove(const Char& ch);
+    void Remove(const CodePointSet& chars);
+    // Single pass. An empty replace removes the matched characters
     void Replace(const Char& find, const Char& replace);
+    void Replace(const CodePointSet& find, const Char& replace);
+    void Replace(const CharMap& map);
 
     bool ReplaceString(const String& find, const String& replace);
 
+    // Replaces every non-overlapping occurrence of find, left to right, and
+    // returns the number of replacements. An empty find replaces nothing
+    size_t ReplaceAll(const StringView& find, const StringView& replace);
+
     // Extract substring
     String Substr(size_t pos = 0, size_t count = std::string::npos) const;
 
     // Split & Join
+    StringArray Split(const CodePointSet& delimiters) const;
     StringArray Split(const CharSet& delimiters) const;
     StringArray Split(const char* delimiters) const;
     static String Join(const StringArray& arr, const Char& delimiter);
 
+    // Same tokens as Split without copying them. The range refers to this
+    // string
+    SplitRange Tokenize(const CodePointSet& delimiters) const;
+
     // Search
+    bool StartsWith(const StringView& str) const;
     bool StartsWith(const String& str) const;
     bool StartsWith(const AnsiPtr& ptr) const;
     bool StartsWith(const Utf8Ptr& ptr) const;
@@ -97,6 +149,7 @@ namespace utf8
     bool StartsWith(const std::string& str) const;
     bool StartsWith(const char* ptr) const;
 
+    bool EndsWith(const StringView& str) const;
     bool EndsWith(const String& str) const;
     bool EndsWith(const AnsiPtr& ptr) const;
     bool EndsWith(const Utf8Ptr& ptr) const;
@@ -108,6 +161,7 @@ namespace utf8
     bool EndsWith(const std::string& str) const;
     bool EndsWith(const char* ptr) const;
 
+    bool Includes(const StringView& str, size_t pos = 0) const;
     bool Includes(const String& str, size_t pos = 0) const;
     bool Includes(const AnsiPtr& ptr, size_t pos = 0) const;
     bool Includes(const Utf8Ptr& ptr, size_t pos = 0) const;
@@ -119,6 +173,7 @@ namespace utf8
     bool Includes(const std::string& str, size_t pos = 0) const;
     bool Includes(const char* ptr, size_t pos = 0) const;
 
+    size_t IndexOf(const StringView& str, size_t Off = 0U) const;
     size_t IndexOf(const String& str, size_t Off = 0U) const;
     size_t IndexOf(const AnsiPtr& ptr, size_t Off = 0U) const;
     size_t IndexOf(const Utf8Ptr& ptr, size_t Off = 0U) const;
@@ -130,6 +185,7 @@ namespace utf8
     size_t IndexOf(const std::string& str, size_t Off = 0U) const;
     size_t IndexOf(const char* ptr, size_t Off = 0U) const;
 
+    size_t LastIndexOf(const StringView& str) const;
     size_t LastIndexOf(const String& str) const;
     size_t LastIndexOf(const AnsiPtr& ptr) const;
     size_t LastIndexOf(const Utf8Ptr& ptr) const;
@@ -142,6 +198,7 @@ namespace utf8
     size_t LastIndexOf(const char* ptr) const;
 
     // --- operator==
+    bool operator==(const StringView& str) const;
     bool operator==(const String& str) const;
     bool operator==(const AnsiPtr& ptr) const;
     bool operator==(const Utf8Ptr& ptr) const;
@@ -153,6 +210,7 @@ namespace utf8
     bool operator==(const char* ptr) const;
     bool operator==(const std::string& str) const;
 
+    bool IsEqual(const StringView& str) const;
     bool IsEqual(const String& str) const;
     bool IsEqual(const AnsiPtr& ptr) const;
     bool IsEqual(const Utf8Ptr& ptr) const;
@@ -176,6 +234,7 @@ namespace utf8
     bool IsEqualNoCase(const char* ptr) const;
 
     // --- operator!=
+    bool operator!=(const StringView& str) const;
     bool operator!=(const String& str) const;
     bool operator!=(const AnsiPtr& ptr) const;
     bool operator!=(const Utf8Ptr& ptr) const;
@@ -189,6 +248,7 @@ namespace utf8
 
     // --- operator=
     String& operator=(const String& str);
+    String& operator=(String&& str) noexcept;
     String& operator=(const AnsiPtr& ptr);
     String& operator=(const Utf8Ptr& ptr);
     String& operator=(const w16string& str);
@@ -198,6 +258,7 @@ namespace utf8
     String& operator=(const Char& ch);
     String& operator=(const char*);
     String& operator=(const std::string&);
+    String& operator=(std::string&&);
 
     // --- operator+=
     String& operator+=(const String& str);
@@ -212,17 +273,31 @@ namespace utf8
     String& operator+=(const std::string&);
 
     // --- operator+
-    String operator+(const String& str) const;
-    String operator+(const AnsiPtr& ptr) const;
-    String operator+(const Utf8Ptr& ptr) const;
-    String operator+(const w16string& str) const;
-    String operator+(const w16_type* ptr) const;
-    String operator+(const w32string& str) const;
-    String operator+(const w32_type* ptr) const;
-    String operator+(const Char& ch) const;
-    String operator+(char ch) const;
-    String operator+(const char* ptr) const;
-    String operator+(const std::string&) const;
+    // The result is allocated once. A temporary left operand is extended in
+    // place, so a + b + c reuses the buffer of a + b
+    String operator+(const String& str) const&;
+    String operator+(const AnsiPtr& ptr) const&;
+    String operator+(const Utf8Ptr& ptr) const&;
+    String operator+(const w16string& str) const&;
+    String operator+(const w16_type* ptr) const&;
+    String operator+(const w32string& str) const&;
+    String operator+(const w32_type* ptr) const&;
+    String operator+(const Char& ch) const&;
+    String operator+(char ch) const&;
+    String operator+(const char* ptr) const&;
+    String operator+(const std::string&) const&;
+
+    String operator+(const String& str) &&;
+    String operator+(const AnsiPtr& ptr) &&;
+    String operator+(const Utf8Ptr& ptr) &&;
+    String operator+(const w16string& str) &&;
+    String operator+(const w16_type* ptr) &&;
+    String operator+(const w32string& str) &&;
+    String operator+(const w32_type* ptr) &&;
+    String operator+(const Char& ch) &&;
+    String operator+(char ch) &&;
+    String operator+(const char* ptr) &&;
+    String operator+(const std::string&) &&;
 
     // --- operator< (searching in map for example)
     bool operator<(const String& str) const;
@@ -240,8 +315,12 @@ namespace utf8
     static size_t CharSize(const char* p);
 
     static bool Valid(const char* p);
+    static bool Valid(const char* p, size_t size);
     static bool Valid(const std::string& str);
+
+    // Returns pointer to the first invalid sequence or nullptr
     static const char* Verify(const char* ptr);
+    static const char* Verify(const char* ptr, size_t size);
 
     // Aliases
     bool empty() const { return Empty(); }
@@ -252,10 +331,28 @@ namespace utf8
     template<typename T> size_t rfind(T t) { return LastIndexOf(t); }
 
   private:
+    String& Append(const std::string& utf8);
+    String& Append(const char* utf8, size_t size);
+    String& Append(const char* utf8, size_t size, size_t len);
+    String Concat(const char* utf8, size_t size, size_t len) const;
+
+    // left + str for the free operator+
+    static String Concat(const char* left, size_t size, const String& str);
+
     size_t PtrToPos(const char* p0) const;
     size_t PosToBitPos(const size_t& pos) const;
+
+    size_t ByteOffset(size_t charIndex) const;
+    const Index* GetIndex() const;
+    void BuildIndex(Index& index) const;
+    void DropIndex();
+    void PatchIndex(size_t charIndex);
+    void ShiftIndex(size_t charIndex, ptrdiff_t bytes, int chars);
   };
 
   String operator+(const char* left, const String& str);
   String operator+(const std::string& left, const String& str);
+
+  // Number of characters (code points) in size bytes of utf8 text
+  size_t Utf8Length(const char* ptr, size_t size);
 }
\ No newline at end of file
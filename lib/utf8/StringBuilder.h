@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+
+#include <utf8/Char.h>
+#include <utf8/ConstStringPtr.h>
+#include <utf8/Convert.h>
+#include <utf8/StringView.h>
+
+namespace utf8
+{
+  class String;
+
+  // Accumulates UTF-8 output. UTF-16, UTF-32 and ANSI input is transcoded
+  // straight into the buffer and the length is tracked on the way, so
+  // Build() hands the buffer over to a String without copying or counting
+  //
+  //   StringBuilder sb(4096);
+  //   sb.Append(u"utf-16 ").Append(U"utf-32 ").Append(AnsiPtr(ansi));
+  //   String str = sb.Build();
+  class StringBuilder
+  {
+    std::string Data;
+    size_t Len;                 // Number of characters in Data
+
+  public:
+    StringBuilder();
+    explicit StringBuilder(size_t bytes);
+
+    // Reserves room for bytes more bytes of UTF-8
+    void Reserve(size_t bytes);
+
+    bool Empty() const;
+    size_t Length() const;      // Length in characters
+    size_t Size() const;        // Size in bytes
+
+    StringBuilder& Append(const String& str);
+    StringBuilder& Append(const StringView& utf8);
+    StringBuilder& Append(const std::string& utf8);
+    StringBuilder& Append(const char* utf8);
+    StringBuilder& Append(const Char& ch);
+    StringBuilder& Append(const AnsiPtr& ptr);
+
+    // Malformed UTF-16 / UTF-32 input is not appended
+    StringBuilder& Append(const w16string& str);
+    StringBuilder& Append(const w16_type* ptr, size_t n = -1);
+    StringBuilder& Append(const w32string& str);
+    StringBuilder& Append(const w32_type* ptr, size_t n = -1);
+
+    // Moves the text into a String and leaves the builder empty
+    String Build();
+    void Clear();
+  };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+
+#include <utf8/CharIterator.h>
+#include <utf8/CodePointSet.h>
+
+namespace utf8
+{
+  class SplitRange;
+  class String;
+
+  // Non-owning reference to UTF-8 text: pointer, size in bytes and, when
+  // known, length in characters. The text must outlive the view. Positions
+  // and lengths are in characters as for String
+  class StringView
+  {
+    const char* Ptr;
+    size_t Bytes;
+    size_t Len;                 // npos if not known
+
+  public:
+    static const size_t npos = size_t(-1);
+
+    StringView();
+    StringView(const char* utf8);
+    StringView(const char* utf8, size_t size, size_t len = npos);
+    StringView(const std::string& utf8);
+    StringView(const String& str);
+
+    const char* data() const { return Ptr; }
+    std::string Str() const;
+
+    bool Empty() const;
+    size_t Length() const;      // Counted on each call when not known
+    size_t Size() const;        // Size in bytes
+
+    // Iteration over characters, dereferences to char32_t
+    CharIterator begin() const { return CharIterator(Ptr); }
+    CharIterator end() const { return CharIterator(Ptr + Bytes); }
+
+    StringView Substr(size_t pos = 0, size_t count = npos) const;
+
+    // Same tokens as String::Split, returned lazily as views
+    SplitRange Split(const CodePointSet& delimiters) const;
+
+    bool StartsWith(const StringView& str) const;
+    bool EndsWith(const StringView& str) const;
+    bool Includes(const StringView& str, size_t pos = 0) const;
+
+    size_t IndexOf(const StringView& str, size_t Off = 0U) const;
+    size_t LastIndexOf(const StringView& str) const;
+
+    bool operator==(const StringView& str) const;
+    bool operator!=(const StringView& str) const;
+    bool operator<(const StringView& str) const;
+
+    // Aliases
+    bool empty() const { return Empty(); }
+    size_t size() const { return Size(); }
+  };
+}
+
+#include <utf8/SplitRange.h>
@@ -0,0 +1,31 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/CaseMap.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/CaseMap.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/CaseMap.cpp.o.d"
+  "/root/repo/lib/CaseTables.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/CaseTables.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/CaseTables.cpp.o.d"
+  "/root/repo/lib/Char.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/Char.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/Char.cpp.o.d"
+  "/root/repo/lib/CodePointSet.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/CodePointSet.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/CodePointSet.cpp.o.d"
+  "/root/repo/lib/Convert.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/Convert.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/Convert.cpp.o.d"
+  "/root/repo/lib/EditBatch.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/EditBatch.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/EditBatch.cpp.o.d"
+  "/root/repo/lib/Rope.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/Rope.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/Rope.cpp.o.d"
+  "/root/repo/lib/Simd.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/Simd.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/Simd.cpp.o.d"
+  "/root/repo/lib/SplitRange.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/SplitRange.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/SplitRange.cpp.o.d"
+  "/root/repo/lib/String.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/String.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/String.cpp.o.d"
+  "/root/repo/lib/StringBuilder.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/StringBuilder.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/StringBuilder.cpp.o.d"
+  "/root/repo/lib/StringView.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/StringView.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/StringView.cpp.o.d"
+  "/root/repo/lib/Transcode.cpp" "/root/repo/out/Static/CMakeFiles/utf8.dir/Transcode.cpp.o" "gcc" "/root/repo/out/Static/CMakeFiles/utf8.dir/Transcode.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
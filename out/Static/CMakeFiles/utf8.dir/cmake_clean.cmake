@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "/root/repo/_gate_build/libutf8.a"
+  "/root/repo/_gate_build/libutf8.pdb"
+  "CMakeFiles/utf8.dir/CaseMap.cpp.o"
+  "CMakeFiles/utf8.dir/CaseMap.cpp.o.d"
+  "CMakeFiles/utf8.dir/CaseTables.cpp.o"
+  "CMakeFiles/utf8.dir/CaseTables.cpp.o.d"
+  "CMakeFiles/utf8.dir/Char.cpp.o"
+  "CMakeFiles/utf8.dir/Char.cpp.o.d"
+  "CMakeFiles/utf8.dir/CodePointSet.cpp.o"
+  "CMakeFiles/utf8.dir/CodePointSet.cpp.o.d"
+  "CMakeFiles/utf8.dir/Convert.cpp.o"
+  "CMakeFiles/utf8.dir/Convert.cpp.o.d"
+  "CMakeFiles/utf8.dir/EditBatch.cpp.o"
+  "CMakeFiles/utf8.dir/EditBatch.cpp.o.d"
+  "CMakeFiles/utf8.dir/Rope.cpp.o"
+  "CMakeFiles/utf8.dir/Rope.cpp.o.d"
+  "CMakeFiles/utf8.dir/Simd.cpp.o"
+  "CMakeFiles/utf8.dir/Simd.cpp.o.d"
+  "CMakeFiles/utf8.dir/SplitRange.cpp.o"
+  "CMakeFiles/utf8.dir/SplitRange.cpp.o.d"
+  "CMakeFiles/utf8.dir/String.cpp.o"
+  "CMakeFiles/utf8.dir/String.cpp.o.d"
+  "CMakeFiles/utf8.dir/StringBuilder.cpp.o"
+  "CMakeFiles/utf8.dir/StringBuilder.cpp.o.d"
+  "CMakeFiles/utf8.dir/StringView.cpp.o"
+  "CMakeFiles/utf8.dir/StringView.cpp.o.d"
+  "CMakeFiles/utf8.dir/Transcode.cpp.o"
+  "CMakeFiles/utf8.dir/Transcode.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utf8.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
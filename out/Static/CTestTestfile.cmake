@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/lib
+# Build directory: /root/repo/out/Static
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
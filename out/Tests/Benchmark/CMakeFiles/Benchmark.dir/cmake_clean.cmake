@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/_gate_build/Benchmark"
+  "/root/repo/_gate_build/Benchmark.pdb"
+  "CMakeFiles/Benchmark.dir/Benchmark.cpp.o"
+  "CMakeFiles/Benchmark.dir/Benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "/root/repo/_gate_build/LiteralsTest"
+  "/root/repo/_gate_build/LiteralsTest.pdb"
+  "CMakeFiles/LiteralsTest.dir/Literals.cpp.o"
+  "CMakeFiles/LiteralsTest.dir/Literals.cpp.o.d"
+  "LiteralsTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LiteralsTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/StringTest/Allocations.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Allocations.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Allocations.cpp.o.d"
+  "/root/repo/tests/StringTest/Char.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Char.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Char.cpp.o.d"
+  "/root/repo/tests/StringTest/CodePointSet.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/CodePointSet.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/CodePointSet.cpp.o.d"
+  "/root/repo/tests/StringTest/Convert.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Convert.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Convert.cpp.o.d"
+  "/root/repo/tests/StringTest/EditBatch.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/EditBatch.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/EditBatch.cpp.o.d"
+  "/root/repo/tests/StringTest/Rope.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Rope.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Rope.cpp.o.d"
+  "/root/repo/tests/StringTest/Split.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Split.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Split.cpp.o.d"
+  "/root/repo/tests/StringTest/StringBuilder.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringBuilder.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringBuilder.cpp.o.d"
+  "/root/repo/tests/StringTest/StringTest.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringTest.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringTest.cpp.o.d"
+  "/root/repo/tests/StringTest/StringView.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringView.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/StringView.cpp.o.d"
+  "/root/repo/tests/StringTest/Template.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Template.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Template.cpp.o.d"
+  "/root/repo/tests/StringTest/Verify.cpp" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Verify.cpp.o" "gcc" "/root/repo/out/Tests/StringTest/CMakeFiles/StringTest.dir/Verify.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/out/Static/CMakeFiles/utf8.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,34 @@
+file(REMOVE_RECURSE
+  "/root/repo/_gate_build/StringTest"
+  "/root/repo/_gate_build/StringTest.pdb"
+  "CMakeFiles/StringTest.dir/Allocations.cpp.o"
+  "CMakeFiles/StringTest.dir/Allocations.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Char.cpp.o"
+  "CMakeFiles/StringTest.dir/Char.cpp.o.d"
+  "CMakeFiles/StringTest.dir/CodePointSet.cpp.o"
+  "CMakeFiles/StringTest.dir/CodePointSet.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Convert.cpp.o"
+  "CMakeFiles/StringTest.dir/Convert.cpp.o.d"
+  "CMakeFiles/StringTest.dir/EditBatch.cpp.o"
+  "CMakeFiles/StringTest.dir/EditBatch.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Rope.cpp.o"
+  "CMakeFiles/StringTest.dir/Rope.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Split.cpp.o"
+  "CMakeFiles/StringTest.dir/Split.cpp.o.d"
+  "CMakeFiles/StringTest.dir/StringBuilder.cpp.o"
+  "CMakeFiles/StringTest.dir/StringBuilder.cpp.o.d"
+  "CMakeFiles/StringTest.dir/StringTest.cpp.o"
+  "CMakeFiles/StringTest.dir/StringTest.cpp.o.d"
+  "CMakeFiles/StringTest.dir/StringView.cpp.o"
+  "CMakeFiles/StringTest.dir/StringView.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Template.cpp.o"
+  "CMakeFiles/StringTest.dir/Template.cpp.o.d"
+  "CMakeFiles/StringTest.dir/Verify.cpp.o"
+  "CMakeFiles/StringTest.dir/Verify.cpp.o.d"
+  "StringTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/StringTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/StringTest
+# Build directory: /root/repo/out/Tests/StringTest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/out/Tests/StringTest/StringTest[1]_include.cmake")
+include("/root/repo/out/Tests/StringTest/LiteralsTest[1]_include.cmake")
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/out/Tests/StringTest/LiteralsTest[1]_tests.cmake")
+  include("/root/repo/out/Tests/StringTest/LiteralsTest[1]_tests.cmake")
+else()
+  add_test(LiteralsTest_NOT_BUILT LiteralsTest_NOT_BUILT)
+endif()
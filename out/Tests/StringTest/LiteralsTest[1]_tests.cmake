@@ -0,0 +1,5 @@
+add_test([=[Literals.MatchRuntime]=]  /root/repo/_gate_build/LiteralsTest [==[--gtest_filter=Literals.MatchRuntime]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Literals.MatchRuntime]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Literals.Malformed]=]  /root/repo/_gate_build/LiteralsTest [==[--gtest_filter=Literals.Malformed]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Literals.Malformed]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  LiteralsTest_TESTS Literals.MatchRuntime Literals.Malformed)
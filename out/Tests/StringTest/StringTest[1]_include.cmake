@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/out/Tests/StringTest/StringTest[1]_tests.cmake")
+  include("/root/repo/out/Tests/StringTest/StringTest[1]_tests.cmake")
+else()
+  add_test(StringTest_NOT_BUILT StringTest_NOT_BUILT)
+endif()
@@ -0,0 +1,169 @@
+add_test([=[Char.Layout]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Char.Layout]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Char.Layout]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Char.Order]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Char.Order]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Char.Order]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Char.NoAllocations]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Char.NoAllocations]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Char.NoAllocations]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Char.MatchesConverters]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Char.MatchesConverters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Char.MatchesConverters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Char.ConstructionNoAllocations]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Char.ConstructionNoAllocations]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Char.ConstructionNoAllocations]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CodePointSet.Contains]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=CodePointSet.Contains]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CodePointSet.Contains]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CodePointSet.Ranges]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=CodePointSet.Ranges]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CodePointSet.Ranges]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CodePointSet.FromCharSet]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=CodePointSet.FromCharSet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CodePointSet.FromCharSet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.SplitCodePointSet]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.SplitCodePointSet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.SplitCodePointSet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.TrimCodePointSet]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.TrimCodePointSet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.TrimCodePointSet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.RemoveCodePointSet]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.RemoveCodePointSet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.RemoveCodePointSet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConvertDirect]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConvertDirect]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConvertDirect]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConstructorAnsi]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConstructorAnsi]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConstructorAnsi]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConstructorUtf8]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConstructorUtf8]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConstructorUtf8]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConstructorUtf16]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConstructorUtf16]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConstructorUtf16]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConstructorUtf32]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConstructorUtf32]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConstructorUtf32]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Constructor_Char]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Constructor_Char]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Constructor_Char]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.LengthNeSize]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.LengthNeSize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.LengthNeSize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Length]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Length]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Length]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.LengthTracksEdits]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.LengthTracksEdits]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.LengthTracksEdits]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Utf8Length]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Utf8Length]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Utf8Length]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.PositionIndex]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.PositionIndex]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.PositionIndex]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.SizeOf]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.SizeOf]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.SizeOf]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.OffsetOf]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.OffsetOf]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.OffsetOf]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Item]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Item]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Item]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.RemoveAt]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.RemoveAt]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.RemoveAt]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.InsertAt]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.InsertAt]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.InsertAt]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ReplaceAt]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ReplaceAt]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ReplaceAt]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConversionAnsi]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConversionAnsi]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConversionAnsi]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConversionUtf8]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConversionUtf8]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConversionUtf8]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ConversionWstring]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ConversionWstring]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ConversionWstring]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ToLowerCase]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ToLowerCase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ToLowerCase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ToUpperCase]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ToUpperCase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ToUpperCase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.CaseMapping]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.CaseMapping]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.CaseMapping]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.OperatorConstruct]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.OperatorConstruct]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.OperatorConstruct]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.IsEqualNoCase]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.IsEqualNoCase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.IsEqualNoCase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Substr]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Substr]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Substr]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.StartsWith]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.StartsWith]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.StartsWith]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.EndsWith]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.EndsWith]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.EndsWith]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Includes]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Includes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Includes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.IndexOf]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.IndexOf]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.IndexOf]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.LastIndexOf]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.LastIndexOf]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.LastIndexOf]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.CompareEq]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.CompareEq]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.CompareEq]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.CompareNe]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.CompareNe]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.CompareNe]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.SplitJoin]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.SplitJoin]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.SplitJoin]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.TrimLeft]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.TrimLeft]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.TrimLeft]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.TrimRight]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.TrimRight]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.TrimRight]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Trim]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Trim]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Trim]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Char]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Char]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Char]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Iterator]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Iterator]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Iterator]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ReplaceAll]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ReplaceAll]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ReplaceAll]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.ReplaceChars]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.ReplaceChars]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.ReplaceChars]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.EditsInPlace]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.EditsInPlace]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.EditsInPlace]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.Concatenation]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.Concatenation]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.Concatenation]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.xstrlen]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.xstrlen]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.xstrlen]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.xstrcpy]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.xstrcpy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.xstrcpy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.xstrncpy]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.xstrncpy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.xstrncpy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[String.xstrncpyz]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=String.xstrncpyz]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[String.xstrncpyz]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.Utf8ToUtf16]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.Utf8ToUtf16]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.Utf8ToUtf16]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.Utf8ToUtf16Native]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.Utf8ToUtf16Native]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.Utf8ToUtf16Native]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.Utf8ToUtf32Direct]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.Utf8ToUtf32Direct]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.Utf8ToUtf32Direct]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.Utf32ToUtf8Presized]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.Utf32ToUtf8Presized]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.Utf32ToUtf8Presized]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.AnsiToUtf8Threads]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.AnsiToUtf8Threads]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.AnsiToUtf8Threads]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.AnsiToUtf8Fork]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.AnsiToUtf8Fork]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.AnsiToUtf8Fork]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akString.AnsiToUtf8SmallStack]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akString.AnsiToUtf8SmallStack]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akString.AnsiToUtf8SmallStack]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[EditBatch.Apply]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=EditBatch.Apply]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[EditBatch.Apply]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[EditBatch.Invalid]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=EditBatch.Invalid]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[EditBatch.Invalid]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[EditBatch.MatchesModel]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=EditBatch.MatchesModel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[EditBatch.MatchesModel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Rope.Basic]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Rope.Basic]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Rope.Basic]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Rope.MatchesModel]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Rope.MatchesModel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Rope.MatchesModel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[akUtf8String.Split]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=akUtf8String.Split]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[akUtf8String.Split]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Split.AsciiDelimiters]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Split.AsciiDelimiters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Split.AsciiDelimiters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Split.Tokenize]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Split.Tokenize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Split.Tokenize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Split.TokenizeIterator]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Split.TokenizeIterator]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Split.TokenizeIterator]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringBuilder.MixedEncodings]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringBuilder.MixedEncodings]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringBuilder.MixedEncodings]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringBuilder.MatchesConverters]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringBuilder.MatchesConverters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringBuilder.MatchesConverters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringBuilder.KeepsReservedBuffer]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringBuilder.KeepsReservedBuffer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringBuilder.KeepsReservedBuffer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringView.Basics]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringView.Basics]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringView.Basics]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringView.Substr]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringView.Substr]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringView.Substr]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringView.MatchesString]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringView.MatchesString]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringView.MatchesString]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringView.Split]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=StringView.Split]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringView.Split]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Verify.Valid]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Verify.Valid]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Verify.Valid]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Verify.Rejected]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Verify.Rejected]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Verify.Rejected]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Verify.MatchesReference]=]  /root/repo/_gate_build/StringTest [==[--gtest_filter=Verify.MatchesReference]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Verify.MatchesReference]=]  PROPERTIES WORKING_DIRECTORY /root/repo/out/Tests/StringTest SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  StringTest_TESTS Char.Layout Char.Order Char.NoAllocations Char.MatchesConverters Char.ConstructionNoAllocations CodePointSet.Contains CodePointSet.Ranges CodePointSet.FromCharSet String.SplitCodePointSet String.TrimCodePointSet String.RemoveCodePointSet String.ConvertDirect String.ConstructorAnsi String.ConstructorUtf8 String.ConstructorUtf16 String.ConstructorUtf32 String.Constructor_Char String.LengthNeSize String.Length String.LengthTracksEdits String.Utf8Length String.PositionIndex String.SizeOf String.OffsetOf String.Item String.RemoveAt String.InsertAt String.ReplaceAt String.ConversionAnsi String.ConversionUtf8 String.ConversionWstring String.ToLowerCase String.ToUpperCase String.CaseMapping String.OperatorConstruct String.IsEqualNoCase String.Substr String.StartsWith String.EndsWith String.Includes String.IndexOf String.LastIndexOf String.CompareEq String.CompareNe String.SplitJoin String.TrimLeft String.TrimRight String.Trim String.Char String.Iterator String.ReplaceAll String.ReplaceChars String.EditsInPlace String.Concatenation String.xstrlen String.xstrcpy String.xstrncpy String.xstrncpyz akString.Utf8ToUtf16 akString.Utf8ToUtf16Native akString.Utf8ToUtf32Direct akString.Utf32ToUtf8Presized akString.AnsiToUtf8Threads akString.AnsiToUtf8Fork akString.AnsiToUtf8SmallStack EditBatch.Apply EditBatch.Invalid EditBatch.MatchesModel Rope.Basic Rope.MatchesModel akUtf8String.Split Split.AsciiDelimiters Split.Tokenize Split.TokenizeIterator StringBuilder.MixedEncodings StringBuilder.MatchesConverters StringBuilder.KeepsReservedBuffer StringView.Basics StringView.Substr StringView.MatchesString StringView.Split Verify.Valid Verify.Rejected Verify.MatchesReference)
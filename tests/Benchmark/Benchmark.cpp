@@ -0,0 +1,350 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utf8/String.h>
+
+#ifndef _WIN32
+  #include <iconv.h>
+#endif
+
+#include "../StringTest/SplitData.cpi"
+
+// Prints the average cost of an operation in nanoseconds per call. Run the
+// Release build: Benchmark [filter]
+
+using namespace utf8;
+
+typedef std::chrono::steady_clock Clock;
+
+template<typename F>
+static double NsPerCall(size_t count, F f)
+{
+  auto start = Clock::now();
+  for (size_t i = 0; i < count; ++i)
+    f();
+
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  return elapsed.count() / double(count);
+}
+
+// Runs f on n threads at the same time, returns the average per call cost
+template<typename F>
+static double NsPerCallThreads(size_t threads, size_t count, F f)
+{
+  std::vector<double> results(threads);
+  std::vector<std::thread> pool;
+
+  for (size_t i = 0; i < threads; ++i)
+    pool.emplace_back([&, i]() { results[i] = NsPerCall(count, f); });
+
+  double total = 0;
+  for (size_t i = 0; i < threads; ++i)
+  {
+    pool[i].join();
+    total += results[i];
+  }
+  return total / double(threads);
+}
+
+static void Report(const char* name, double ns)
+{
+  printf("%-48s %12.1f ns\n", name, ns);
+}
+
+static bool Selected(const char* filter, const char* name)
+{
+  return filter == nullptr || strstr(name, filter) != nullptr;
+}
+
+#ifndef _WIN32
+// What posixEncodeString did before descriptors were cached
+static std::string OpenConvertClose(const char* ptr, const char* from, const char* to)
+{
+  iconv_t h = iconv_open(to, from);
+
+  size_t cbin = strlen(ptr);
+  size_t cbout = 4 * cbin;
+  std::vector<char> buffer(cbout + 1);
+
+  char* in = (char*)ptr;
+  char* out = &buffer[0];
+  iconv(h, &in, &cbin, &out, &cbout);
+  iconv_close(h);
+
+  return std::string(&buffer[0]);
+}
+
+static void IconvBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "iconv"))
+    return;
+
+  const char* ansi = "short \xc0\xc1\xc2 text";
+  const size_t count = 100000;
+  const size_t threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+
+  Report("iconv open/convert/close, 1 thread", NsPerCall(count, [&]() {
+    OpenConvertClose(ansi, "WINDOWS-1251", "UTF-16LE");
+  }));
+
+  Report("AnsiToUtf16 (cached descriptors), 1 thread", NsPerCall(count, [&]() {
+    AnsiToUtf16(ansi);
+  }));
+
+  Report("iconv open/convert/close, all threads", NsPerCallThreads(threads, count / 4, [&]() {
+    OpenConvertClose(ansi, "WINDOWS-1251", "UTF-16LE");
+  }));
+
+  Report("AnsiToUtf16 (cached descriptors), all threads", NsPerCallThreads(threads, count / 4, [&]() {
+    AnsiToUtf16(ansi);
+  }));
+}
+#endif
+
+// Bytes per nanosecond is the same number as GB/s
+static void ReportBandwidth(const char* name, size_t bytes, double ns)
+{
+  printf("%-48s %12.2f GB/s\n", name, double(bytes) / ns);
+}
+
+static void LengthBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "length"))
+    return;
+
+  std::string text;
+  while (text.size() < 8 * 1024 * 1024)
+    text += u8"log line with some ascii, немного кириллицы и 王明 ";
+
+  size_t total = 0;
+  double ns = NsPerCall(20, [&]() {
+    total += Utf8Length(text.c_str(), text.size());
+  });
+  ReportBandwidth("Utf8Length, 8 MB mixed text", text.size(), ns);
+
+  ns = NsPerCall(20, [&]() {
+    size_t n = 0;
+    for (const char* p = text.c_str(); *p; p += String::CharSize(p))
+      n++;
+    total += n;
+  });
+  ReportBandwidth("CharSize loop, 8 MB mixed text", text.size(), ns);
+
+  if (total == 0)
+    printf("unexpected\n");
+}
+
+static void SplitBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "split"))
+    return;
+
+  String text(SplitData);
+  CharSet chars{ Char(' '), Char('\n') };
+  CodePointSet set(chars);
+  size_t total = 0;
+
+  // Membership test only: what Split pays per input character
+  double ns = NsPerCall(20, [&]() {
+    Char ch;
+    for (const char* p = text.c_str(); *p; ++p)
+    {
+      ch.clear();
+      ch.push_back(*p);
+      total += chars.count(ch);
+    }
+  });
+  ReportBandwidth("CharSet lookups, SplitData", text.Size(), ns);
+
+  ns = NsPerCall(20, [&]() {
+    for (const char* p = text.c_str(); *p; ++p)
+      total += set.Contains(p, 1);
+  });
+  ReportBandwidth("CodePointSet lookups, SplitData", text.Size(), ns);
+
+  ns = NsPerCall(20, [&]() {
+    total += text.Split(set).size();
+  });
+  ReportBandwidth("Split, SplitData", text.Size(), ns);
+
+  ns = NsPerCall(20, [&]() {
+    for (auto& token : text.Tokenize(set))
+      total += token.Size();
+  });
+  ReportBandwidth("Tokenize, SplitData", text.Size(), ns);
+
+  if (total == 0)
+    printf("unexpected\n");
+}
+
+// What ReplaceString did before it became a single pass
+static void ReplaceBySubstr(String& str, const String& find, const String& replace)
+{
+  size_t startPos = 0;
+  size_t newStartPos = 0;
+  while ((newStartPos = str.IndexOf(find, startPos)) != std::string::npos)
+  {
+    str = str.Substr(0, newStartPos) + replace + str.Substr(newStartPos + find.Length());
+    startPos = newStartPos + replace.Length();
+  }
+}
+
+static void ReplaceBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "replace"))
+    return;
+
+  // Template with 2000 placeholders
+  String page;
+  for (int i = 0; i < 2000; ++i)
+    page += u8"<td class=\"cell\">{value}</td> <!-- ячейка --> ";
+
+  String find("{value}");
+  String replace(u8"значение");
+
+  Report("ReplaceString by Substr, 2000 matches", NsPerCall(3, [&]() {
+    String str(page);
+    ReplaceBySubstr(str, find, replace);
+  }));
+
+  Report("ReplaceAll, 2000 matches", NsPerCall(100, [&]() {
+    String str(page);
+    str.ReplaceAll(find, replace);
+  }));
+}
+
+static void EditBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "edit"))
+    return;
+
+  String text;
+  while (text.Size() < 64 * 1024)
+    text += u8"строка текста with ascii 王明\n";
+
+  size_t len = text.Length();
+  size_t i = 0;
+
+  Report("InsertAt + RemoveAt, 64 KB text", NsPerCall(100000, [&]() {
+    size_t pos = (i++ * 7919) % len;
+    text.InsertAt(pos, Char(U'ж'));
+    text.RemoveAt(pos);
+  }));
+
+  Report("ReplaceAt, 64 KB text", NsPerCall(100000, [&]() {
+    text.ReplaceAt((i++ * 7919) % len, Char(U'ж'));
+  }));
+
+  // Same plan of 500 removals and 500 insertions both ways
+  String copy;
+  size_t step = len / 501;
+
+  Report("500 RemoveAt + 500 InsertAt, 64 KB text", NsPerCall(20, [&]() {
+    copy = text;
+    for (size_t pos = step * 500; pos >= step; pos -= step)
+    {
+      copy.RemoveAt(pos);
+      copy.InsertAt(pos - step / 2, Char(U'ж'));
+    }
+  }));
+
+  Report("EditBatch of 1000 edits, 64 KB text", NsPerCall(20, [&]() {
+    EditBatch edits;
+    for (size_t pos = step * 500; pos >= step; pos -= step)
+      edits.Remove(pos).Insert(pos - step / 2, u8"ж");
+
+    copy = text;
+    edits.Apply(copy);
+  }));
+
+  String doc;
+  while (doc.Size() < 8 * 1024 * 1024)
+    doc += text;
+
+  Rope rope(doc);
+  size_t docLen = doc.Length();
+
+  Report("InsertAt + RemoveAt, 8 MB String", NsPerCall(1000, [&]() {
+    size_t pos = (i++ * 7919) % docLen;
+    doc.InsertAt(pos, Char(U'ж'));
+    doc.RemoveAt(pos);
+  }));
+
+  Report("InsertAt + RemoveAt, 8 MB Rope", NsPerCall(100000, [&]() {
+    size_t pos = (i++ * 7919) % docLen;
+    rope.InsertAt(pos, u8"ж");
+    rope.RemoveAt(pos);
+  }));
+}
+
+static void BuilderBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "builder"))
+    return;
+
+  const w16_type* w16 = (const w16_type*)u"UTF-16 строка 王明, ";
+  const w32_type* w32 = (const w32_type*)U"UTF-32 строка 王明, ";
+
+  Report("String += 1000 UTF-16 and UTF-32 pieces", NsPerCall(1000, [&]() {
+    String str;
+    for (int i = 0; i < 500; ++i)
+    {
+      str += w16;
+      str += w32;
+    }
+  }));
+
+  Report("StringBuilder, same pieces", NsPerCall(1000, [&]() {
+    StringBuilder sb(32 * 1024);
+    for (int i = 0; i < 500; ++i)
+      sb.Append(w16).Append(w32);
+
+    String str = sb.Build();
+  }));
+}
+
+static void CaseBenchmarks(const char* filter)
+{
+  if (!Selected(filter, "case"))
+    return;
+
+  String ascii;
+  String mixed;
+  while (ascii.Size() < 64 * 1024)
+  {
+    ascii += "The Quick Brown Fox Jumps Over The Lazy Dog. ";
+    mixed += u8"Съешь же ещё этих мягких французских булок. ";
+  }
+
+  Report("ToUpperCase + ToLowerCase, 64 KB ASCII", NsPerCall(1000, [&]() {
+    ascii.ToUpperCase();
+    ascii.ToLowerCase();
+  }));
+
+  Report("ToUpperCase + ToLowerCase, 64 KB Cyrillic", NsPerCall(1000, [&]() {
+    mixed.ToUpperCase();
+    mixed.ToLowerCase();
+  }));
+}
+
+int main(int argc, char* argv[])
+{
+  const char* filter = argc > 1 ? argv[1] : nullptr;
+
+  LengthBenchmarks(filter);
+  SplitBenchmarks(filter);
+  ReplaceBenchmarks(filter);
+  EditBenchmarks(filter);
+  BuilderBenchmarks(filter);
+  CaseBenchmarks(filter);
+
+#ifndef _WIN32
+  IconvBenchmarks(filter);
+#endif
+
+  return 0;
+}
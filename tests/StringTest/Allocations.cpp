@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <new>
+
+#include "Allocations.h"
+
+// Total number of allocations made by the test binary
+static size_t Allocations = 0;
+
+AllocationCounter::AllocationCounter()
+  : Start(Allocations)
+{
+}
+
+size_t AllocationCounter::Count() const
+{
+  return Allocations - Start;
+}
+
+// The complete set of replaceable allocation functions is overridden, so
+// every form of new is counted and every delete frees with the matching
+// allocator
+static void* Allocate(size_t size)
+{
+  Allocations++;
+  return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+  if (void* p = Allocate(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return Allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+  free(p);
+}
+
+#ifdef __cpp_aligned_new
+static void* AllocateAligned(size_t size, std::align_val_t align)
+{
+  Allocations++;
+
+  // aligned_alloc needs a multiple of the alignment
+  size_t a = size_t(align);
+  return aligned_alloc(a, (size + a - 1) / a * a);
+}
+
+void* operator new(size_t size, std::align_val_t align)
+{
+  if (void* p = AllocateAligned(size, align))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align)
+{
+  return operator new(size, align);
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+  return AllocateAligned(size, align);
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+  return AllocateAligned(size, align);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+  free(p);
+}
+#endif
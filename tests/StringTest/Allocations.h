@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts heap allocations of the test binary. Allocations.cpp replaces the
+// global operator new and delete for that
+//
+//   AllocationCounter allocations;
+//   ...
+//   EXPECT_EQ(allocations.Count(), 0U);
+class AllocationCounter
+{
+  size_t Start;
+
+public:
+  AllocationCounter();
+
+  // Allocations made since construction
+  size_t Count() const;
+};
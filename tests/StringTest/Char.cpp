@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+#include "Allocations.h"
+
+#include <type_traits>
+#include <unordered_set>
+
+using namespace utf8;
+
+TEST(Char, Layout)
+{
+  EXPECT_TRUE(std::is_trivially_copyable<Char>::value);
+  EXPECT_LE(sizeof(Char), 8U);
+
+  Char ch(U'\x1F600');
+  Char copy;
+  copy = ch;
+  EXPECT_EQ(copy.size(), 4U);
+  EXPECT_EQ(copy.Str(), u8"\U0001F600");
+  EXPECT_TRUE(copy == ch);
+}
+
+TEST(Char, Order)
+{
+  Char a('a'), b('b'), ya(U'я'), wang(U'王'), emoji(U'\x1F600');
+
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(b < ya);
+  EXPECT_TRUE(ya < wang);
+  EXPECT_TRUE(wang < emoji);
+  EXPECT_FALSE(emoji < wang);
+  EXPECT_FALSE(a < a);
+
+  std::unordered_set<Char> set{ a, ya, wang };
+  EXPECT_EQ(set.count(Char(U'я')), 1U);
+  EXPECT_EQ(set.count(b), 0U);
+}
+
+TEST(Char, NoAllocations)
+{
+  String s(u8"abc-абв-王-\U0001F600 ");
+  for (int i = 0; i < 5; ++i)
+    s += s;
+
+  Char dash('-'), wang(U'王');
+  CharSet delimiters{ dash, wang };
+  size_t count = s.Length();
+  s.CharAt(count - 1);
+
+  AllocationCounter allocations;
+  size_t matches = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    Char ch = s.CharAt(i);
+    if (ch == dash || s[i] == wang)
+      matches++;
+
+    if (delimiters.find(ch) != delimiters.end())
+      matches++;
+  }
+
+  Char last = s.LastChar();
+  EXPECT_EQ(allocations.Count(), 0U);
+  EXPECT_EQ(matches, 2 * 4 * 32U);
+  EXPECT_EQ(last, Char(' '));
+}
+
+TEST(Char, MatchesConverters)
+{
+  for (int c = 1; c < 256; ++c)
+  {
+#ifndef _WIN32
+    if (c == 0x98)
+      continue;
+#endif
+    char str[2]{ char(c), '\0' };
+    EXPECT_EQ(Char(char(c)).Str(), AnsiToUtf8(str)) << c;
+  }
+
+  for (char32_t cp = 1; cp < 0x110000; cp += (cp < 0x1000 ? 1 : 97))
+  {
+    if (cp >= 0xD800 && cp <= 0xDFFF)
+      continue;
+
+    char32_t str[2]{ cp, 0 };
+    EXPECT_EQ(Char(cp).Str(), Utf32ToUtf8((const w32_type*)str)) << cp;
+
+    if (cp < 0x10000)
+    {
+      EXPECT_EQ(Char(char16_t(cp)), Char(cp)) << cp;
+    }
+  }
+
+  EXPECT_TRUE(Char(char32_t(0xD800)).empty());
+  EXPECT_TRUE(Char(char32_t(0x110000)).empty());
+  EXPECT_TRUE(Char(char16_t(0xDC00)).empty());
+  EXPECT_TRUE(Char('\0').empty());
+  EXPECT_EQ(Char(L'ж'), Char(U'ж'));
+}
+
+TEST(Char, ConstructionNoAllocations)
+{
+  AllocationCounter allocations;
+  size_t count = 0;
+
+  for (int c = 1; c < 256; ++c)
+    count += Char(char(c)).size();
+
+  for (char32_t cp = 1; cp < 0x110000; cp += 101)
+    count += Char(cp).size() + Char(char16_t(cp)).size();
+
+  String s(u8"  abc  ");
+  s.Trim();
+
+  EXPECT_EQ(allocations.Count(), 0U);
+  EXPECT_GT(count, 0U);
+  EXPECT_TRUE(Char(' ') == ' ');
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+using namespace utf8;
+
+TEST(CodePointSet, Contains)
+{
+  CodePointSet set(u8" ,я王\U0001F600");
+  set.Insert(U'\x3041', U'\x3096');          // Hiragana
+
+  EXPECT_TRUE(set.Contains(U' '));
+  EXPECT_TRUE(set.Contains(Char(',')));
+  EXPECT_TRUE(set.Contains(Char(U'я')));
+  EXPECT_TRUE(set.Contains(U'王'));
+  EXPECT_TRUE(set.Contains(U'\x1F600'));
+  EXPECT_TRUE(set.Contains(U'\x3042'));
+  EXPECT_TRUE(set.Contains(U'\x3096'));
+
+  EXPECT_FALSE(set.Contains(U'a'));
+  EXPECT_FALSE(set.Contains(U'ю'));
+  EXPECT_FALSE(set.Contains(U'\x3097'));
+  EXPECT_FALSE(set.Contains(U'\x1F601'));
+  EXPECT_FALSE(set.Contains(Char()));
+  EXPECT_FALSE(set.Contains("\xC0\xA0", 2));  // Overlong space
+
+  EXPECT_FALSE(set.Empty());
+  EXPECT_TRUE(CodePointSet().Empty());
+}
+
+TEST(CodePointSet, Ranges)
+{
+  CodePointSet set;
+  set.Insert(U'\x1000', U'\x1010');
+  set.Insert(U'\x1020', U'\x1030');
+  set.Insert(U'\x1011', U'\x101F');          // Joins both ranges
+  set.Insert(U'\x7F0', U'\x805');            // Crosses the bitmap limit
+
+  for (char32_t cp = 0x7F0; cp <= 0x1030; ++cp)
+    EXPECT_EQ(set.Contains(cp), cp <= 0x805 || cp >= 0x1000) << cp;
+
+  EXPECT_FALSE(set.Contains(U'\x1031'));
+
+  set.Insert(U'\x10FFF0', char32_t(-1));     // Clamped to U+10FFFF
+  EXPECT_TRUE(set.Contains(U'\x10FFFF'));
+  EXPECT_TRUE(set.Contains(U'\x1000'));
+}
+
+TEST(CodePointSet, FromCharSet)
+{
+  CharSet chars{ Char(' '), Char(U'я'), Char(U'王') };
+  CodePointSet set(chars);
+
+  for (char32_t cp = 1; cp < 0x10000; ++cp)
+    EXPECT_EQ(set.Contains(cp), chars.count(Char(cp)) == 1) << cp;
+}
+
+TEST(String, SplitCodePointSet)
+{
+  String s(u8"a,б;王,,\U0001F600");
+
+  StringArray tokens = s.Split(CodePointSet(u8",;"));
+  ASSERT_EQ(tokens.size(), 5U);
+  EXPECT_EQ(tokens[0], u8"a");
+  EXPECT_EQ(tokens[1], u8"б");
+  EXPECT_EQ(tokens[2], u8"王");
+  EXPECT_EQ(tokens[3], u8"");
+  EXPECT_EQ(tokens[4], u8"\U0001F600");
+
+  EXPECT_EQ(s.Split(CharSet{ Char(',') }).size(), 4U);
+  EXPECT_EQ(s.Split(u8"王").size(), 2U);
+}
+
+TEST(String, TrimCodePointSet)
+{
+  String s(u8" \t–王 x 王– \t");
+  s.Trim(CodePointSet(u8" \t–"));
+  EXPECT_EQ(s, u8"王 x 王");
+  EXPECT_EQ(s.Length(), 5U);
+
+  s.TrimLeft(CodePointSet(u8"王"));
+  EXPECT_EQ(s, u8" x 王");
+
+  s.TrimRight(CodePointSet(u8"王 "));
+  EXPECT_EQ(s, u8" x");
+  EXPECT_EQ(s.Length(), 2U);
+
+  s.Trim(CodePointSet(u8" x"));
+  EXPECT_TRUE(s.Empty());
+  EXPECT_EQ(s.Length(), 0U);
+}
+
+TEST(String, RemoveCodePointSet)
+{
+  String s(u8"я-王-a-\U0001F600-я");
+  s.Remove(CodePointSet(u8"-я"));
+  EXPECT_EQ(s, u8"王a\U0001F600");
+  EXPECT_EQ(s.Length(), 3U);
+  EXPECT_EQ(s.LastChar(), Char(U'\x1F600'));
+
+  String nul(std::string("a-\0-b-", 6));
+  nul.Remove(CodePointSet("-"));
+  EXPECT_EQ(nul.Str(), std::string("a\0b", 3));
+  EXPECT_EQ(nul.Length(), 3U);
+}
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 #include <utf8/String.h>
 
+#include <thread>
+
+#ifndef _WIN32
+  #include <pthread.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
 using namespace utf8;
 
 extern const char* SplitData;
@@ -15,4 +23,126 @@ TEST(akString, Utf8ToUtf16)
 {
   auto str1 = Utf8ToUtf16("");
   EXPECT_EQ(str1, w16string());
-}
\ No newline at end of file
+}
+TEST(akString, Utf8ToUtf16Native)
+{
+  auto str1 = Utf8ToUtf16(u8"plain ascii text longer than a block");
+  EXPECT_EQ(str1, w16string((w16_type*)u"plain ascii text longer than a block"));
+
+  auto str2 = Utf8ToUtf16(u8"тЕкст1 王明 Mötley Crüe \U0001F600!");
+  EXPECT_EQ(str2, w16string((w16_type*)u"тЕкст1 王明 Mötley Crüe \U0001F600!"));
+  EXPECT_EQ(str2[str2.size() - 3], 0xD83D);
+  EXPECT_EQ(str2[str2.size() - 2], 0xDE00);
+
+  String str(SplitData);
+  auto str3 = Utf8ToUtf16(str);
+  EXPECT_EQ(str3.size(), str.Size());
+  EXPECT_EQ(Utf16ToUtf8(str3.c_str()), str.Str());
+}
+
+TEST(akString, Utf8ToUtf32Direct)
+{
+  auto str1 = Utf8ToUtf32(u8"");
+  EXPECT_EQ(str1, w32string());
+
+  const char32_t* text = U"Съешь же ещё этих мягких французских булок, да выпей чаю. 王明 \U0001F600 Mötley Crüe";
+  std::string utf8 = Utf32ToUtf8((const w32_type*)text);
+
+  auto str2 = Utf8ToUtf32(utf8.c_str());
+  EXPECT_EQ(str2, w32string((const w32_type*)text));
+
+  String str(SplitData);
+  w32string w32 = Utf8ToUtf32(str);
+  EXPECT_EQ(w32.size(), str.Size());
+  EXPECT_EQ(Utf32ToUtf8(w32.c_str()), str.Str());
+}
+
+TEST(akString, Utf32ToUtf8Presized)
+{
+  EXPECT_EQ(Utf32ToUtf8((const w32_type*)U""), std::string());
+
+  const char32_t* text = U"ascii only block of text, "
+    U"ЖЖЖЖЖЖЖЖЖЖЖЖЖЖЖЖ äöüßÄÖÜ 王明 \U0001F600\U0010FFFF";
+  std::string utf8 = Utf32ToUtf8((const w32_type*)text);
+  EXPECT_EQ(utf8, u8"ascii only block of text, ЖЖЖЖЖЖЖЖЖЖЖЖЖЖЖЖ äöüßÄÖÜ 王明 \U0001F600\U0010FFFF");
+  EXPECT_EQ(Utf32ToUtf8((const w32_type*)text, 3), "asc");
+
+  // Surrogates and values above U+10FFFF are rejected
+  const w32_type bad1[] = { 'a', 'b', 'c', 'd', 'e', 0xD800, 'f', 0 };
+  const w32_type bad2[] = { 'a', 0x110000, 0 };
+  EXPECT_EQ(Utf32ToUtf8(bad1), std::string());
+  EXPECT_EQ(Utf32ToUtf8(bad2), std::string());
+}
+
+TEST(akString, AnsiToUtf8Threads)
+{
+  const char* ansi = "1234567890\xc0\xc1\xc2\xc3";
+  const std::string expected = AnsiToUtf8(ansi);
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(8);
+
+  for (size_t i = 0; i < failures.size(); ++i)
+  {
+    threads.emplace_back([&, i]() {
+      for (int n = 0; n < 1000; ++n)
+      {
+        if (AnsiToUtf8(ansi) != expected || Utf8ToAnsi(expected.c_str()) != ansi)
+          failures[i]++;
+      }
+    });
+  }
+
+  for (auto& t : threads)
+    t.join();
+
+  for (auto n : failures)
+    EXPECT_EQ(n, 0);
+}
+
+#ifndef _WIN32
+TEST(akString, AnsiToUtf8Fork)
+{
+  const char* ansi = "\xc0\xc1\xc2\xc3";
+  const std::string expected = AnsiToUtf8(ansi);
+
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+
+  if (pid == 0)
+    _exit(AnsiToUtf8(ansi) == expected ? 0 : 1);
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_EQ(AnsiToUtf8(ansi), expected);
+}
+#endif
+
+#ifndef _WIN32
+static void* ConvertLargeInput(void* arg)
+{
+  // 4 MB of ANSI text is converted on a thread with a 256 KB stack
+  std::string ansi(4 * 1024 * 1024, '\xc0');
+  std::string utf8 = AnsiToUtf8(ansi.c_str());
+
+  *(bool*)arg = utf8.size() == 2 * ansi.size() && utf8.compare(0, 4, u8"АА") == 0;
+  return nullptr;
+}
+
+TEST(akString, AnsiToUtf8SmallStack)
+{
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, 256 * 1024);
+
+  bool ok = false;
+  pthread_t thread;
+  ASSERT_EQ(pthread_create(&thread, &attr, ConvertLargeInput, &ok), 0);
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+
+  EXPECT_TRUE(ok);
+}
+#endif
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace utf8;
+
+TEST(EditBatch, Apply)
+{
+  String s(u8"привет, мир王");
+
+  EditBatch edits;
+  edits.Replace(8, 3, "world").Remove(6).Insert(0, u8"«").Insert(11, u8"»");
+  edits.Insert(0, ">");
+
+  EXPECT_EQ(edits.Size(), 5);
+  EXPECT_TRUE(edits.Apply(s));
+  EXPECT_EQ(s, u8"«>привет world»王");
+  EXPECT_EQ(s.Length(), 16);
+
+  // Positions refer to the original string, inserts at one position keep
+  // their order
+  String t("abc");
+  EditBatch order;
+  order.Insert(1, "2").Remove(1).Insert(1, "1").Insert(3, "!");
+  EXPECT_TRUE(order.Apply(t));
+  EXPECT_EQ(t, "a21c!");
+
+  String empty;
+  EXPECT_TRUE(EditBatch().Apply(empty));
+  EXPECT_TRUE(EditBatch().Insert(0, u8"я").Apply(empty));
+  EXPECT_EQ(empty, u8"я");
+}
+
+TEST(EditBatch, Invalid)
+{
+  String s(u8"абвгд");
+
+  // Overlapping removals
+  EXPECT_FALSE(EditBatch().Remove(1, 2).Remove(2).Apply(s));
+  // Insert inside a removed range
+  EXPECT_FALSE(EditBatch().Remove(1, 3).Insert(2, "x").Apply(s));
+  // Out of range
+  EXPECT_FALSE(EditBatch().Insert(6, "x").Apply(s));
+  EXPECT_FALSE(EditBatch().Remove(4, 2).Apply(s));
+  EXPECT_FALSE(EditBatch().Remove(std::string::npos, 2).Apply(s));
+
+  EXPECT_EQ(s, u8"абвгд");
+  EXPECT_EQ(s.Length(), 5);
+
+  // Insert at the end of a removed range is fine
+  EXPECT_TRUE(EditBatch().Remove(1, 3).Insert(4, "x").Apply(s));
+  EXPECT_EQ(s, u8"аxд");
+}
+
+TEST(EditBatch, MatchesModel)
+{
+  String s;
+  for (int i = 0; i < 300; ++i)
+    s += u8"аб王c\U0001F600";
+
+  // Keep the position index alive across the batch
+  EXPECT_EQ(s.CharAt(1000), Char(U'а'));
+
+  std::u32string ref(s.begin(), s.end());
+  std::mt19937 rng(5);
+  const char* inserts[] = { "", "x", u8"жж", u8"王", u8"\U0001F600y" };
+
+  for (int round = 0; round < 20; ++round)
+  {
+    EditBatch edits;
+    std::vector<std::pair<size_t, std::pair<size_t, std::u32string>>> model;
+
+    // Non-overlapping edits in random order
+    for (size_t pos = rng() % 8; pos < ref.size(); pos += 1 + rng() % 16)
+    {
+      size_t count = std::min<size_t>(rng() % 4, ref.size() - pos);
+      String text(inserts[rng() % 5]);
+
+      model.push_back(std::make_pair(pos, std::make_pair(count, std::u32string(text.begin(), text.end()))));
+      pos += count;
+    }
+
+    std::shuffle(model.begin(), model.end(), rng);
+    for (auto& m : model)
+    {
+      String text;
+      for (char32_t cp : m.second.second)
+        text += Char(cp);
+
+      edits.Replace(m.first, m.second.first, text);
+    }
+
+    ASSERT_TRUE(edits.Apply(s));
+
+    // Apply back to front so earlier positions stay valid
+    std::sort(model.begin(), model.end());
+    for (auto m = model.rbegin(); m != model.rend(); ++m)
+      ref.replace(m->first, m->second.first, m->second.second);
+
+    ASSERT_EQ(s.Length(), ref.size());
+    ASSERT_EQ(std::u32string(s.begin(), s.end()), ref);
+
+    size_t probe = rng() % ref.size();
+    ASSERT_EQ(s.CharAt(probe), Char(ref[probe]));
+  }
+}
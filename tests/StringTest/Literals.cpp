@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <utf8/Literals.h>
+#include <utf8/String.h>
+
+using namespace utf8;
+using namespace utf8::literals;
+
+// Evaluated by the compiler
+constexpr Char Dash = '-'_u8c;
+constexpr Char Ya = U'я'_u8c;
+constexpr Char Emoji = U'\x1F600'_u8c;
+constexpr auto Name = "тест-王明"_u8s;
+
+static_assert(Dash.size() == 1 && Dash[0] == '-', "ASCII");
+static_assert(Ya.size() == 2 && Ya[0] == char(0xD1) && Ya[1] == char(0x8F), "2 bytes");
+static_assert(u'王'_u8c.size() == 3, "3 bytes");
+static_assert(Emoji.size() == 4 && Emoji[0] == char(0xF0), "4 bytes");
+static_assert("王"_u8c.size() == 3, "single character string");
+static_assert(Name.Size() == 15 && Name.Length() == 7, "string constant");
+static_assert(""_u8s.Empty() && ""_u8s.Length() == 0, "empty string");
+
+static_assert(SequenceSize("\xC0\xAF", 2) == 0, "overlong");
+static_assert(SequenceSize("\xED\xA0\x80", 3) == 0, "surrogate");
+static_assert(SequenceSize("\xF4\x90\x80\x80", 4) == 0, "above U+10FFFF");
+static_assert(SequenceSize("\xEF\xBF\xBF", 3) == 0, "U+FFFF");
+static_assert(SequenceSize("\xE2\x82", 2) == 0, "truncated");
+
+TEST(Literals, MatchRuntime)
+{
+  EXPECT_EQ(Dash, Char('-'));
+  EXPECT_EQ(Ya, Char(U'я'));
+  EXPECT_EQ(Emoji, Char(U'\x1F600'));
+  EXPECT_EQ(L'ж'_u8c, Char(U'ж'));
+  EXPECT_TRUE(U'\0'_u8c.empty());
+
+  String s(Name.c_str());
+  EXPECT_EQ(s.Length(), Name.Length());
+  EXPECT_TRUE(Name == s.Str());
+  EXPECT_TRUE(Name == s.c_str());
+  EXPECT_TRUE(Name != "тест");
+  EXPECT_EQ(s.IndexOf(Dash), 4U);
+}
+
+TEST(Literals, Malformed)
+{
+  const char bad[] = "a\xC0\xAF";
+  EXPECT_THROW(StringLiteral<char>(bad, 3), std::invalid_argument);
+  EXPECT_THROW(Encode(char32_t(0xD800)), std::invalid_argument);
+  EXPECT_THROW(Encode(char32_t(0x110000)), std::invalid_argument);
+  EXPECT_THROW(SingleChar("ab", 2), std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+#include <random>
+
+using namespace utf8;
+
+TEST(Rope, Basic)
+{
+  Rope rope(u8"привет, мир王");
+  EXPECT_EQ(rope.Length(), 12);
+  EXPECT_EQ(rope.Size(), 23);
+  EXPECT_EQ(rope.CharAt(11), Char(U'王'));
+  EXPECT_EQ(rope.CharAt(12), Char());
+
+  EXPECT_TRUE(rope.InsertAt(6, u8" большой"));
+  EXPECT_TRUE(rope.RemoveAt(0, 3));
+  EXPECT_TRUE(rope.InsertAt(std::string::npos, "!"));
+  EXPECT_FALSE(rope.InsertAt(100, "x"));
+  EXPECT_FALSE(rope.RemoveAt(100));
+
+  EXPECT_EQ(rope.ToString(), u8"вет большой, мир王!");
+  EXPECT_EQ(rope.ToString().Length(), 18);
+  EXPECT_EQ(rope.Substr(4, 7), u8"большой");
+  EXPECT_EQ(rope.Substr(16), u8"王!");
+  EXPECT_EQ(rope.Substr(18), "");
+
+  Rope copy(rope);
+  copy.Clear();
+  EXPECT_TRUE(copy.Empty());
+  EXPECT_EQ(rope.Length(), 18);
+
+  copy = rope;
+  rope.RemoveAt(0, rope.Length());
+  EXPECT_TRUE(rope.Empty());
+  EXPECT_EQ(copy.Substr(0, 3), u8"вет");
+
+  Rope moved(std::move(copy));
+  EXPECT_EQ(moved.Length(), 18);
+}
+
+TEST(Rope, MatchesModel)
+{
+  String text;
+  for (int i = 0; i < 2000; ++i)
+    text += u8"аб王c\U0001F600";
+
+  Rope rope(text);
+  EXPECT_EQ(rope.ToString(), text);
+
+  std::u32string ref(text.begin(), text.end());
+  std::mt19937 rng(7);
+  const char* inserts[] = { "x", u8"жж", u8"王", u8"\U0001F600y" };
+
+  String big;
+  for (int i = 0; i < 300; ++i)
+    big += u8"длинная вставка ";
+
+  for (int i = 0; i < 3000; ++i)
+  {
+    size_t pos = rng() % (ref.size() + 1);
+
+    switch (rng() % 4)
+    {
+    case 0:
+    case 1:
+      {
+        String str(i % 100 == 0 ? big : String(inserts[rng() % 4]));
+        ASSERT_TRUE(rope.InsertAt(pos, str));
+        ref.insert(pos, std::u32string(str.begin(), str.end()));
+      }
+      break;
+    case 2:
+      {
+        size_t count = rng() % 600;
+        ASSERT_EQ(rope.RemoveAt(pos, count), pos < ref.size());
+        if (pos < ref.size())
+          ref.erase(pos, count);
+      }
+      break;
+    case 3:
+      {
+        size_t count = rng() % 1500;
+        String sub = rope.Substr(pos, count);
+        std::u32string expected = pos < ref.size() ? ref.substr(pos, count) : std::u32string();
+        ASSERT_EQ(std::u32string(sub.begin(), sub.end()), expected);
+        ASSERT_EQ(sub.Length(), expected.size());
+      }
+      break;
+    }
+
+    ASSERT_EQ(rope.Length(), ref.size());
+    if (!ref.empty())
+    {
+      size_t probe = rng() % ref.size();
+      ASSERT_EQ(rope.CharAt(probe), Char(ref[probe])) << i;
+    }
+  }
+
+  String str = rope.ToString();
+  EXPECT_EQ(std::u32string(str.begin(), str.end()), ref);
+  EXPECT_EQ(rope.Size(), str.Size());
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <utf8/String.h>
 
+#include <random>
+
 #include "SplitData.cpi"
 
 using namespace utf8;
@@ -10,3 +12,94 @@ TEST(akUtf8String, Split)
   String lutStr(SplitData);
   StringArray splittedLutStr = lutStr.Split({' '});
 }
+
+// Character by character split the byte scanning version must agree with
+static StringArray ReferenceSplit(const String& str, const CharSet& delimiters)
+{
+  StringArray tokens;
+  String token;
+
+  for (size_t i = 0; i < str.Length(); ++i)
+  {
+    Char ch = str[i];
+    if (delimiters.count(ch))
+    {
+      tokens.push_back(token);
+      token.Clear();
+    }
+    else
+      token += ch;
+  }
+
+  tokens.push_back(token);
+  return tokens;
+}
+
+TEST(Split, AsciiDelimiters)
+{
+  const char* pieces[] = { "a", "0.5", u8"я", u8"王", u8"\U0001F600", ",", ";", " ", "\t", "|", "~", "@" };
+  std::mt19937 rng(7);
+
+  CharSet small{ Char(','), Char(' ') };
+  CharSet large{ Char(','), Char(';'), Char(' '), Char('\t'), Char('|'), Char('~'), Char('@'), Char('a'), Char('5'), Char('.') };
+
+  for (size_t size : { 1, 15, 16, 31, 32, 33, 100, 1000 })
+  {
+    std::string text;
+    while (text.size() < size)
+      text += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+    String str(text);
+    EXPECT_EQ(str.Split(small), ReferenceSplit(str, small)) << text;
+    EXPECT_EQ(str.Split(large), ReferenceSplit(str, large)) << text;
+  }
+}
+
+static StringArray Collect(const SplitRange& range)
+{
+  StringArray tokens;
+  for (auto& token : range)
+  {
+    EXPECT_EQ(token.Length(), Utf8Length(token.data(), token.Size()));
+    tokens.push_back(String(token.data(), token.Size()));
+  }
+  return tokens;
+}
+
+TEST(Split, Tokenize)
+{
+  const char* texts[] = { "", ",", "a", "a,", ",a", u8"a,,б;王", u8"王;\U0001F600,,", u8"я я" };
+  CodePointSet sets[] = { CodePointSet(",;"), CodePointSet(u8",王"), CodePointSet(u8"я") };
+
+  for (auto text : texts)
+  {
+    String str(text);
+    for (auto& set : sets)
+      EXPECT_EQ(Collect(str.Tokenize(set)), str.Split(set)) << text;
+  }
+
+  String data(SplitData);
+  EXPECT_EQ(Collect(data.Tokenize(" ")), data.Split(" "));
+}
+
+TEST(Split, TokenizeIterator)
+{
+  String str(u8"ab,,王");
+  SplitRange range = str.Tokenize(",");
+
+  auto it = range.begin();
+  EXPECT_EQ(it->Str(), "ab");
+  EXPECT_EQ(it->data(), str.c_str());
+
+  auto prev = it++;
+  EXPECT_EQ(prev->Str(), "ab");
+  EXPECT_TRUE(it->Empty());
+
+  ++it;
+  EXPECT_EQ(it->Str(), u8"王");
+  EXPECT_EQ(it->Size(), 3U);
+  EXPECT_EQ(it->Length(), 1U);
+
+  EXPECT_TRUE(++it == range.end());
+  EXPECT_EQ(std::distance(range.begin(), range.end()), 3);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+#include "Allocations.h"
+
+using namespace utf8;
+
+TEST(StringBuilder, MixedEncodings)
+{
+  StringBuilder sb(64);
+  EXPECT_TRUE(sb.Empty());
+
+  sb.Append(String(u8"王明 "))
+    .Append(u8"привет ")
+    .Append(std::string("std "))
+    .Append(Char(U'ж'))
+    .Append((const w16_type*)u"utf-16 \U0001F600 ")
+    .Append(w32string((const w32_type*)U"utf-32 \U0001F600 "))
+    .Append(AnsiPtr("ansi \xC6"));
+
+  String expected(u8"王明 привет std жutf-16 \U0001F600 utf-32 \U0001F600 ansi Ж");
+  EXPECT_EQ(sb.Length(), expected.Length());
+  EXPECT_EQ(sb.Size(), expected.Size());
+
+  String str = sb.Build();
+  EXPECT_EQ(str, expected);
+  EXPECT_EQ(str.Length(), expected.Length());
+  EXPECT_EQ(str.CharAt(2), Char(' '));
+
+  EXPECT_TRUE(sb.Empty());
+  EXPECT_EQ(sb.Length(), 0);
+}
+
+TEST(StringBuilder, MatchesConverters)
+{
+  w16string w16;
+  w32string w32;
+  for (char32_t cp = 1; cp < 0x11000; cp += 7)
+  {
+    // Surrogates and the U+FFFE / U+FFFF noncharacters String rejects
+    if ((cp >= 0xD800 && cp <= 0xDFFF) || cp == 0xFFFE || cp == 0xFFFF)
+      continue;
+
+    w32 += w32_type(cp);
+    if (cp < 0x10000)
+      w16 += w16_type(cp);
+    else
+    {
+      w16 += w16_type(0xD800 + ((cp - 0x10000) >> 10));
+      w16 += w16_type(0xDC00 + ((cp - 0x10000) & 0x3FF));
+    }
+  }
+
+  StringBuilder sb;
+  sb.Append(w16);
+  EXPECT_EQ(sb.Length(), w32.size());
+  EXPECT_EQ(sb.Build(), String(w32));
+
+  sb.Append(w32);
+  EXPECT_EQ(sb.Build(), Utf16ToUtf8(w16.c_str()));
+
+  // Malformed input is skipped
+  const w16_type lone[] = { 'a', 0xD800, 'b', 0 };
+  const w32_type big[] = { 'a', 0x110000, 0 };
+  sb.Append("x").Append(lone).Append(big).Append("y");
+  EXPECT_EQ(sb.Length(), 2);
+  EXPECT_EQ(sb.Build(), "xy");
+}
+
+TEST(StringBuilder, KeepsReservedBuffer)
+{
+  const w16_type* w16 = (const w16_type*)u"строка 王 \U0001F600 ";
+  const w32_type* w32 = (const w32_type*)U"строка 王 \U0001F600 ";
+
+  // 12 + 1 + 3 + 1 + 4 + 1 bytes per piece
+  StringBuilder sb;
+  sb.Reserve(20 * 22);
+
+  AllocationCounter allocations;
+  for (int i = 0; i < 10; ++i)
+    sb.Append(w16).Append(w32);
+
+  EXPECT_EQ(allocations.Count(), 0U);
+  EXPECT_EQ(sb.Size(), 20U * 22);
+  EXPECT_EQ(sb.Length(), 20U * 11);
+}
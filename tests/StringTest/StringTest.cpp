@@ -2,6 +2,11 @@
 #include <utf8/Convert.h>
 #include <utf8/String.h>
 
+#include <algorithm>
+#include <random>
+
+#include "Allocations.h"
+
 #pragma warning(disable : 4566)
 
 using namespace utf8;
@@ -113,6 +118,106 @@ TEST(String, Length)
   EXPECT_EQ(s1.Length(), 14);
 }
 
+TEST(String, LengthTracksEdits)
+{
+  auto count = [](const String& s) { return Utf8ToUtf32(s).size(); };
+
+  String s1(u8"  Mötley Crüe  ");
+  EXPECT_EQ(s1.Length(), count(s1));
+
+  s1 += u8"王明";
+  s1 += Char(L'Ж');
+  s1 += (w32_type*)U"ёж";
+  s1 += String(u8"ä") + String(u8"ö");
+  EXPECT_EQ(s1.Length(), count(s1));
+
+  s1.RemoveAt(3);
+  s1.InsertAt(1, Char(L'ü'));
+  s1.ReplaceAt(0, Char(L'Ш'));
+  s1.Trim();
+  s1.Remove(L'ü');
+  EXPECT_EQ(s1.Length(), count(s1));
+
+  String s2 = s1.Substr(2, 5);
+  EXPECT_EQ(s2.Length(), 5);
+  EXPECT_EQ(s2.Length(), count(s2));
+
+  String s3(std::move(s1));
+  EXPECT_EQ(s3.Length(), count(s3));
+  EXPECT_EQ(s1.Length(), 0);
+  EXPECT_TRUE(s1.Empty());
+
+  s3.Clear();
+  EXPECT_EQ(s3.Length(), 0);
+  EXPECT_TRUE(s3.Empty());
+}
+
+TEST(String, Utf8Length)
+{
+  std::string text;
+  for (int i = 0; i < 200; ++i)
+    text += u8"aж王\U0001F600";
+
+  // Every prefix that ends on a character boundary
+  size_t expected = 0;
+  for (size_t size = 0; size <= text.size(); ++size)
+  {
+    if (size == text.size() || (text[size] & 0xC0) != 0x80)
+    {
+      EXPECT_EQ(Utf8Length(text.c_str(), size), expected);
+      expected++;
+    }
+  }
+
+  EXPECT_EQ(Utf8Length("", 0), 0);
+  EXPECT_EQ(String(text).Length(), 800);
+}
+
+TEST(String, PositionIndex)
+{
+  w32string w32;
+  for (int i = 0; i < 500; ++i)
+    w32 += (w32_type*)(i % 3 ? U"ж" : (i % 5 ? U"a" : U"王"));
+
+  String str(w32);
+  EXPECT_EQ(str.Length(), w32.size());
+
+  auto check = [&]() {
+    std::string expected = Utf32ToUtf8(w32.c_str());
+    ASSERT_EQ(str.Str(), expected);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < w32.size(); ++i)
+    {
+      size_t size = Utf32ToUtf8(&w32[i], 1).size();
+      ASSERT_EQ(str.OffsetOf(i), offset);
+      ASSERT_EQ(str.SizeOf(i), size);
+      ASSERT_EQ(str.CharAt(i), Char(char32_t(w32[i])));
+      offset += size;
+    }
+  };
+
+  check();
+  EXPECT_EQ(str.IndexOf(Char(U'王'), 1), 15);
+  EXPECT_EQ(str.LastIndexOf(Char(U'a')), 498);
+
+  str.InsertAt(100, Char(U'\U0001F600'));
+  w32.insert(w32.begin() + 100, 0x1F600);
+  check();
+
+  str.RemoveAt(7);
+  w32.erase(w32.begin() + 7);
+  check();
+
+  str.ReplaceAt(300, Char('x'));
+  w32[300] = 'x';
+  check();
+
+  str += u8"ёж";
+  w32 += (w32_type*)U"ёж";
+  check();
+}
+
 TEST(String, SizeOf)
 {
   String s1(Text1Utf16);
@@ -242,6 +347,46 @@ TEST(String, ToUpperCase)
   EXPECT_EQ(s3, u8"TESTSTRING");
 }
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+// Built-in tables: full mappings without language or context rules
+TEST(String, CaseMapping)
+{
+  String s1(u8"Straße ﬁ İ Ǆ ΣΑΣ Ⅻ ᾳ K 𐐀𞤀");
+  s1.ToUpperCase();
+  EXPECT_EQ(s1, u8"STRASSE FI İ Ǆ ΣΑΣ Ⅻ ΑΙ K 𐐀𞤀");
+  EXPECT_EQ(s1.Length(), 28);
+
+  String s2(u8"Straße ﬁ İ Ǆ ΣΑΣ Ⅻ ᾳ K 𐐀𞤀");
+  s2.ToLowerCase();
+  EXPECT_EQ(s2, u8"straße ﬁ i̇ ǆ σασ ⅻ ᾳ k 𐐨𞤢");
+  EXPECT_EQ(s2.Length(), 26);
+
+  // Long ASCII runs, including the neighbours of the letter ranges
+  std::string ascii;
+  for (int i = 0; i < 10; ++i)
+    ascii += "@AZ[`az{ Hello, World! 0123456789~";
+
+  String s3(ascii + u8"ж");
+  s3.ToUpperCase();
+  EXPECT_EQ(s3.Str().substr(0, 34), "@AZ[`AZ{ HELLO, WORLD! 0123456789~");
+  EXPECT_EQ(s3.LastChar(), Char(U'Ж'));
+
+  s3.ToLowerCase();
+  EXPECT_EQ(s3.Str().substr(0, 34), "@az[`az{ hello, world! 0123456789~");
+  EXPECT_EQ(s3.Length(), ascii.size() + 1);
+
+  // Output longer than the input
+  String s4(Char(U'ß'), 1000);
+  s4.ToUpperCase();
+  EXPECT_EQ(s4, std::string(2000, 'S'));
+  EXPECT_EQ(s4.Length(), 2000);
+
+  EXPECT_EQ(Utf8ToUpper(u8"groß"), u8"GROSS");
+  EXPECT_EQ(Utf8ToLower(u8"ГРОМ"), u8"гром");
+  EXPECT_TRUE(String(u8"ΣΑΣ Straße").IsEqualNoCase(String(u8"σασ STRAßE")));
+}
+#endif
+
 TEST(String, OperatorConstruct)
 {
   String s2((w16_type *)u"2");
@@ -504,3 +649,223 @@ TEST(String, Char)
 	  EXPECT_EQ(str, u8" rsfs  \2  qed");
   }
 }
+
+TEST(String, Iterator)
+{
+  String s(u8"aя王\U0001F600b");
+  std::u32string expected = U"aя王\U0001F600b";
+
+  std::u32string forward;
+  for (char32_t ch : s)
+    forward += ch;
+  EXPECT_EQ(forward, expected);
+
+  std::u32string backward(s.rbegin(), s.rend());
+  EXPECT_EQ(backward, std::u32string(expected.rbegin(), expected.rend()));
+
+  EXPECT_EQ(std::distance(s.begin(), s.end()), ptrdiff_t(s.Length()));
+  EXPECT_EQ(std::count(s.begin(), s.end(), U'王'), 1);
+
+  auto it = std::find(s.begin(), s.end(), U'王');
+  ASSERT_NE(it, s.end());
+  EXPECT_EQ(it.Position() - s.c_str(), 3);
+  EXPECT_EQ(it.Size(), 3U);
+  EXPECT_EQ(it.ToChar(), Char(U'王'));
+
+  --it;
+  EXPECT_EQ(*it, U'я');
+  it++;
+  it++;
+  EXPECT_EQ(*it, U'\x1F600');
+
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), StringView(s).begin()));
+
+  String empty;
+  EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(String, ReplaceAll)
+{
+  String s(u8"{name} и {name}: 王{name}");
+  EXPECT_EQ(s.ReplaceAll("{name}", u8"Мир"), 3U);
+  EXPECT_EQ(s, u8"Мир и Мир: 王Мир");
+  EXPECT_EQ(s.Length(), 15U);
+  EXPECT_EQ(s.IndexOf(u8"王"), 11U);
+
+  EXPECT_EQ(s.ReplaceAll(u8"Мир", ""), 3U);
+  EXPECT_EQ(s, u8" и : 王");
+  EXPECT_EQ(s.Length(), 6U);
+
+  EXPECT_EQ(s.ReplaceAll("", "x"), 0U);
+  EXPECT_EQ(s.ReplaceAll("missing", "x"), 0U);
+
+  // Non-overlapping, left to right, replacement is not rescanned
+  String a("aaaaa");
+  EXPECT_EQ(a.ReplaceAll("aa", "a"), 2U);
+  EXPECT_EQ(a, "aaa");
+
+  String b("ab");
+  EXPECT_TRUE(b.ReplaceString(String("b"), String("bb")));
+  EXPECT_EQ(b, "abb");
+  EXPECT_FALSE(b.ReplaceString(String("c"), String("d")));
+
+  String self("xy");
+  EXPECT_EQ(self.ReplaceAll("y", self), 1U);
+  EXPECT_EQ(self, "xxy");
+
+  // Long enough for the position index
+  String big;
+  for (int i = 0; i < 200; ++i)
+    big += u8"текст {x} ";
+  big.CharAt(1000);
+  EXPECT_EQ(big.ReplaceAll("{x}", u8"王"), 200U);
+  EXPECT_EQ(big.Length(), 200U * 8);
+  EXPECT_EQ(big.CharAt(6), Char(U'王'));
+  EXPECT_EQ(big.CharAt(100 * 8 + 6), Char(U'王'));
+}
+
+TEST(String, ReplaceChars)
+{
+  String s(u8"a-б-王-б");
+  s.Replace(Char('-'), Char('+'));
+  EXPECT_EQ(s, u8"a+б+王+б");
+
+  s.Replace(Char(U'б'), Char(U'\x1F600'));
+  EXPECT_EQ(s, u8"a+\U0001F600+王+\U0001F600");
+  EXPECT_EQ(s.Length(), 7U);
+
+  s.Replace(Char('+'), Char());
+  EXPECT_EQ(s, u8"a\U0001F600王\U0001F600");
+  EXPECT_EQ(s.Length(), 4U);
+
+  s.Replace(Char(), Char('x'));
+  EXPECT_EQ(s.Length(), 4U);
+
+  String set(u8"a,b;c  王");
+  set.Replace(CodePointSet(u8",; 王"), Char('_'));
+  EXPECT_EQ(set, "a_b_c___");
+  EXPECT_EQ(set.Length(), 8U);
+
+  set.Replace(CodePointSet("_"), Char());
+  EXPECT_EQ(set, "abc");
+  EXPECT_EQ(set.Length(), 3U);
+
+  CharMap map;
+  map[Char(U'ё')] = Char(U'е');
+  map[Char(U'Ё')] = Char(U'Е');
+  map[Char('"')] = Char(U'«');
+  map[Char('x')] = Char();
+
+  String text(u8"\"Ёлка\" и ёжx");
+  text.Replace(map);
+  EXPECT_EQ(text, u8"«Елка« и еж");
+  EXPECT_EQ(text.Length(), 11U);
+
+  // Text after an embedded NUL is kept and replaced too
+  String nul(std::string("x-\0-x", 5));
+  nul.Replace(CodePointSet("-"), Char('+'));
+  EXPECT_EQ(nul.Str(), std::string("x+\0+x", 5));
+  nul.Replace(map);
+  EXPECT_EQ(nul.Str(), std::string("+\0+", 3));
+  EXPECT_EQ(nul.Length(), 3U);
+
+  // Long enough for the position index
+  String big;
+  for (int i = 0; i < 100; ++i)
+    big += u8"строка-";
+  big.CharAt(500);
+  big.Replace(Char('-'), Char(U'—'));
+  EXPECT_EQ(big.CharAt(7 * 50 + 6), Char(U'—'));
+  big.Replace(Char(U'—'), Char('-'));
+  EXPECT_EQ(big.CharAt(7 * 50 + 6), Char('-'));
+}
+
+TEST(String, EditsInPlace)
+{
+  String s;
+  for (int i = 0; i < 300; ++i)
+    s += u8"аб王c";
+
+  // Keep the position index alive while editing
+  EXPECT_EQ(s.CharAt(1000), Char(U'а'));
+
+  std::u32string ref(s.begin(), s.end());
+  std::mt19937 rng(3);
+  const char32_t chars[] = { U'x', U'ж', U'王', U'\x1F600' };
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    size_t pos = rng() % (ref.size() + 1);
+    char32_t ch = chars[rng() % 4];
+
+    switch (rng() % 3)
+    {
+    case 0:
+      EXPECT_EQ(s.InsertAt(pos, Char(ch)), true);
+      ref.insert(ref.begin() + pos, ch);
+      break;
+    case 1:
+      EXPECT_EQ(s.RemoveAt(pos), pos < ref.size());
+      if (pos < ref.size())
+        ref.erase(ref.begin() + pos);
+      break;
+    case 2:
+      EXPECT_EQ(s.ReplaceAt(pos, Char(ch)), pos < ref.size());
+      if (pos < ref.size())
+        ref[pos] = ch;
+      break;
+    }
+
+    size_t probe = rng() % (ref.size() + 1);
+    ASSERT_EQ(s.Length(), ref.size());
+    if (probe < ref.size())
+    {
+      ASSERT_EQ(s.CharAt(probe), Char(ref[probe])) << i;
+    }
+  }
+
+  EXPECT_EQ(std::u32string(s.begin(), s.end()), ref);
+
+  EXPECT_EQ(s.InsertAt(s.Length() + 1, Char('x')), false);
+  EXPECT_EQ(s.InsertAt(std::string::npos, Char('!')), true);
+  EXPECT_EQ(s.LastChar(), Char('!'));
+}
+
+TEST(String, Concatenation)
+{
+  String a(u8"первая часть строки, ");
+  String b(u8"вторая часть строки, ");
+  String c(u8"третья часть строки");
+
+  String abc = a + b + c;
+  EXPECT_EQ(abc, u8"первая часть строки, вторая часть строки, третья часть строки");
+  EXPECT_EQ(abc.Length(), a.Length() + b.Length() + c.Length());
+  EXPECT_EQ(a, u8"первая часть строки, ");
+
+  EXPECT_EQ(String("x") + Char(U'王') + u8"ж" + std::string("y") + 'z', u8"x王жyz");
+  EXPECT_EQ((String("x") + Char(U'王') + 'z').Length(), 3);
+  EXPECT_EQ(u8"王" + a, u8"王первая часть строки, ");
+  EXPECT_EQ(std::string("y") + String(u8"ж"), u8"yж");
+  EXPECT_EQ((u8"王" + (b + c)).Length(), b.Length() + c.Length() + 1);
+
+  // Each concatenation allocates at most once
+  AllocationCounter allocations;
+  String chain = a + b + c + u8" и ещё немного текста в конце";
+  EXPECT_LE(allocations.Count(), 3U);
+  EXPECT_EQ(chain.Length(), abc.Length() + 29);
+
+  // Buffers are stolen
+  std::string data(100, 'x');
+  AllocationCounter steal;
+  String moved(std::move(data));
+  chain = std::move(moved);
+  EXPECT_EQ(steal.Count(), 0U);
+  EXPECT_EQ(chain.Length(), 100);
+  EXPECT_TRUE(moved.Empty());
+
+  std::string other(50, 'y');
+  AllocationCounter assign;
+  chain = std::move(other);
+  EXPECT_EQ(assign.Count(), 0U);
+  EXPECT_EQ(chain.Length(), 50);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+using namespace utf8;
+
+TEST(StringView, Basics)
+{
+  String str(u8"тест-王明-test");
+  StringView view = str;
+
+  EXPECT_EQ(view.data(), str.c_str());
+  EXPECT_EQ(view.Size(), str.Size());
+  EXPECT_EQ(view.Length(), 12U);
+  EXPECT_EQ(view.Str(), str.Str());
+  EXPECT_TRUE(view == str);
+  EXPECT_TRUE(str == view);
+  EXPECT_FALSE(view.Empty());
+  EXPECT_TRUE(StringView().Empty());
+
+  // Unterminated buffer
+  const char buffer[] = { 'a', 'b', ',', 'c', 'x' };
+  StringView part(buffer, 4);
+  EXPECT_EQ(part.Length(), 4U);
+  EXPECT_EQ(part, "ab,c");
+  EXPECT_EQ(part.IndexOf("x"), StringView::npos);
+  EXPECT_TRUE(part < "ab,d");
+  EXPECT_FALSE(part < "ab");
+}
+
+TEST(StringView, Substr)
+{
+  StringView view(u8"тест-王明");
+
+  EXPECT_EQ(view.Substr(5), u8"王明");
+  EXPECT_EQ(view.Substr(2, 3), u8"ст-");
+  EXPECT_EQ(view.Substr(5, 1).Length(), 1U);
+  EXPECT_TRUE(view.Substr(7).Empty());
+  EXPECT_TRUE(view.Substr(100).Empty());
+  EXPECT_EQ(StringView("ascii").Substr(1, 2), "sc");
+}
+
+TEST(StringView, MatchesString)
+{
+  const char* texts[] = { "", "a", u8"тест-王明-тест", u8"abcабв王明abc\U0001F600abc" };
+  const char* needles[] = { "", "a", "abc", u8"тест", u8"王", u8"\U0001F600a", u8"ю" };
+
+  for (auto text : texts)
+  {
+    String str(text);
+    StringView view(text);
+
+    for (auto needle : needles)
+    {
+      EXPECT_EQ(view.StartsWith(needle), str.StartsWith(needle)) << text << " " << needle;
+      EXPECT_EQ(view.EndsWith(needle), str.EndsWith(needle)) << text << " " << needle;
+      EXPECT_EQ(view.LastIndexOf(needle), str.LastIndexOf(needle)) << text << " " << needle;
+
+      for (size_t off = 0; off <= str.Length() + 1; ++off)
+      {
+        EXPECT_EQ(view.IndexOf(needle, off), str.IndexOf(needle, off)) << text << " " << needle << " " << off;
+        EXPECT_EQ(view.Includes(needle, off), str.Includes(needle, off)) << text << " " << needle << " " << off;
+      }
+    }
+  }
+}
+
+TEST(StringView, Split)
+{
+  std::string request = u8"GET /путь/王 HTTP/1.1";
+  StringView line(request);
+
+  std::vector<std::string> parts;
+  for (auto& token : line.Split(" "))
+    parts.push_back(token.Str());
+
+  ASSERT_EQ(parts.size(), 3U);
+  EXPECT_EQ(parts[1], u8"/путь/王");
+
+  String str(line.Str());
+  EXPECT_EQ(str.IndexOf(StringView(u8"王")), 10U);
+  EXPECT_TRUE(str.EndsWith(StringView("1.1")));
+}
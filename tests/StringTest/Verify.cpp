@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <utf8/String.h>
+
+#include <random>
+
+using namespace utf8;
+
+// Byte by byte validator the vectorized one must agree with
+static const char* ReferenceVerify(const char* ptr)
+{
+  unsigned char* s = (unsigned char*)ptr;
+
+  while (*s)
+  {
+    if (*s < 0x80)
+    {
+      s++;
+      continue;
+    }
+
+    if ((s[0] & 0xe0) == 0xc0)
+    {
+      if ((s[1] & 0xc0) != 0x80 || (s[0] & 0xfe) == 0xc0)
+        return (const char*)s;
+
+      s += 2;
+      continue;
+    }
+
+    if ((s[0] & 0xf0) == 0xe0)
+    {
+      if ((s[1] & 0xc0) != 0x80 ||
+          (s[2] & 0xc0) != 0x80 ||
+          (s[0] == 0xe0 && (s[1] & 0xe0) == 0x80) ||
+          (s[0] == 0xed && (s[1] & 0xe0) == 0xa0) ||
+          (s[0] == 0xef && s[1] == 0xbf && (s[2] & 0xfe) == 0xbe)
+      )
+      {
+        return (const char*)s;
+      }
+      s += 3;
+      continue;
+    }
+
+    if ((s[0] & 0xf8) == 0xf0)
+    {
+      if ((s[1] & 0xc0) != 0x80 ||
+          (s[2] & 0xc0) != 0x80 ||
+          (s[3] & 0xc0) != 0x80 ||
+          (s[0] == 0xf0 && (s[1] & 0xf0) == 0x80) ||
+          (s[0] == 0xf4 && s[1] > 0x8f) || s[0] > 0xf4
+      )
+      {
+        return (const char*)s;
+      }
+      s += 4;
+      continue;
+    }
+    return (const char*)s;
+  }
+  return nullptr;
+}
+
+static std::string MixedText(size_t repeat)
+{
+  std::string text;
+  for (size_t i = 0; i < repeat; ++i)
+    text += u8"Mötley Crüe тЕкст1 王明 \U0001F600 plain ascii run of text ";
+  return text;
+}
+
+TEST(Verify, Valid)
+{
+  std::string text = MixedText(20);
+
+  EXPECT_EQ(String::Verify(text.c_str()), nullptr);
+  EXPECT_EQ(String::Verify(text.c_str(), text.size()), nullptr);
+  EXPECT_TRUE(String::Valid(text));
+  EXPECT_TRUE(String::Valid(""));
+}
+
+TEST(Verify, Rejected)
+{
+  const char* invalid[] = {
+    "\xc0\xaf",          // overlong '/'
+    "\xe0\x80\xaf",      // overlong '/'
+    "\xf0\x80\x80\xaf",  // overlong '/'
+    "\xed\xa0\x80",      // U+D800
+    "\xef\xbf\xbe",      // U+FFFE
+    "\xef\xbf\xbf",      // U+FFFF
+    "\xf4\x90\x80\x80",  // U+110000
+    "\xf5\x80\x80\x80",
+    "\xe2\x82",          // truncated
+    "\x80",
+    "\xff"
+  };
+
+  std::string prefix(100, 'a');
+  for (auto bad : invalid)
+  {
+    std::string text = prefix + bad + prefix;
+    EXPECT_EQ(String::Verify(text.c_str()), text.c_str() + prefix.size()) << bad;
+    EXPECT_FALSE(String::Valid(text));
+  }
+}
+
+TEST(Verify, MatchesReference)
+{
+  std::mt19937 rng(1234);
+  std::string base = MixedText(8);
+
+  for (int i = 0; i < 3000; ++i)
+  {
+    std::string text = base.substr(rng() % 64);
+    size_t pos = rng() % text.size();
+
+    // Corrupt one byte or cut in the middle of a character
+    if (i % 3)
+      text[pos] = char(rng() % 255 + 1);
+    else
+      text.resize(pos);
+
+    EXPECT_EQ(String::Verify(text.c_str()), ReferenceVerify(text.c_str()));
+  }
+}
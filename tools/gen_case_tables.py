@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Generates lib/CaseTables.cpp, the case mapping tables of lib/CaseMap.cpp
+
+  gen_case_tables.py SpecialCasing.txt [UnicodeData.txt] > lib/CaseTables.cpp
+
+Both files come from https://www.unicode.org/Public/<version>/ucd/. Simple
+mappings are read from UnicodeData.txt. Without it they are taken from the
+unicodedata module of the running Python, which must be of the same Unicode
+version as SpecialCasing.txt. Unconditional SpecialCasing entries (ß -> SS,
+ligatures, ...) override the simple mappings; language and context
+dependent ones are not used
+"""
+
+import re
+import sys
+import unicodedata
+
+BLOCK = 64
+
+
+def parse_special(path):
+    lower, upper = {}, {}
+    version = None
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            m = re.match(r"# SpecialCasing-(\d+\.\d+\.\d+)\.txt", line)
+            if m:
+                version = m.group(1)
+
+            data = line.split("#", 1)[0].strip()
+            if not data:
+                continue
+
+            fields = [x.strip() for x in data.split(";")]
+            if len(fields) > 4 and fields[4]:
+                continue  # conditional
+
+            cp = int(fields[0], 16)
+            lower[cp] = [int(x, 16) for x in fields[1].split()]
+            upper[cp] = [int(x, 16) for x in fields[3].split()]
+
+    return lower, upper, version
+
+
+def parse_unicode_data(path):
+    lower, upper = {}, {}
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            fields = line.split(";")
+            cp = int(fields[0], 16)
+            if fields[12]:
+                upper[cp] = [int(fields[12], 16)]
+            if fields[13]:
+                lower[cp] = [int(fields[13], 16)]
+
+    return lower, upper
+
+
+def python_simple(convert):
+    mapping = {}
+    for cp in range(0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+
+        s = convert(chr(cp))
+        if len(s) == 1 and ord(s) != cp:
+            mapping[cp] = [ord(s)]
+
+    return mapping
+
+
+def utf8(cps):
+    return "".join(chr(c) for c in cps).encode("utf-8")
+
+
+def build(mapping, expansions):
+    # Mapping 0 is the identity
+    entries = [(0, 0, 0, 0)]
+    entry_index = {entries[0]: 0}
+    values = {}
+
+    for cp, to in sorted(mapping.items()):
+        if to == [cp]:
+            continue
+
+        if len(to) == 1:
+            entry = (to[0] - cp, 0, 0, 0)
+        else:
+            data = utf8(to)
+            assert len(data) <= 16  # CaseMap.cpp keeps 64 bytes of slack
+            offset = expansions.find(data)
+            if offset < 0:
+                offset = len(expansions)
+                expansions += data
+            entry = (0, offset, len(data), len(to))
+
+        if entry not in entry_index:
+            entry_index[entry] = len(entries)
+            entries.append(entry)
+        values[cp] = entry_index[entry]
+
+    limit = (max(values) // BLOCK + 1) * BLOCK
+
+    blocks = [tuple([0] * BLOCK)]
+    block_index = {blocks[0]: 0}
+    index = []
+    for start in range(0, limit, BLOCK):
+        block = tuple(values.get(cp, 0) for cp in range(start, start + BLOCK))
+        if block not in block_index:
+            block_index[block] = len(blocks)
+            blocks.append(block)
+        index.append(block_index[block])
+
+    assert len(blocks) < 256 and len(entries) < 65536 and len(expansions) < 65536
+    return limit, index, blocks, entries, expansions
+
+
+def emit_table(out, name, limit, index, blocks, entries):
+    out.append("static const uint8_t %sIndex[%d] =" % (name, len(index)))
+    out.append("{")
+    for i in range(0, len(index), 16):
+        out.append("  " + ", ".join("%d" % x for x in index[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+
+    out.append("static const uint16_t %sBlocks[%d][%d] =" % (name, len(blocks), BLOCK))
+    out.append("{")
+    for block in blocks:
+        out.append("  {")
+        for i in range(0, BLOCK, 16):
+            out.append("    " + ", ".join("%d" % x for x in block[i:i + 16]) + ",")
+        out.append("  },")
+    out.append("};")
+    out.append("")
+
+    out.append("static const casemap::Mapping %sMappings[%d] =" % (name, len(entries)))
+    out.append("{")
+    for delta, offset, size, length in entries:
+        out.append("  { %d, %d, %d, %d }," % (delta, offset, size, length))
+    out.append("};")
+    out.append("")
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+
+    special_lower, special_upper, version = parse_special(sys.argv[1])
+
+    if len(sys.argv) > 2:
+        lower, upper = parse_unicode_data(sys.argv[2])
+        source = "UnicodeData.txt and SpecialCasing.txt"
+    else:
+        if version and version != unicodedata.unidata_version:
+            sys.exit("Python has Unicode %s, SpecialCasing.txt is %s" % (unicodedata.unidata_version, version))
+
+        lower = python_simple(str.lower)
+        upper = python_simple(str.upper)
+        source = "SpecialCasing.txt and Python unicodedata"
+
+    lower.update(special_lower)
+    upper.update(special_upper)
+
+    expansions = b""
+    lower_table = build(lower, expansions)
+    expansions = lower_table[4]
+    upper_table = build(upper, expansions)
+    expansions = upper_table[4]
+
+    out = []
+    out.append("// Generated by tools/gen_case_tables.py from %s" % source)
+    out.append("// (Unicode %s). Do not edit" % (version or unicodedata.unidata_version))
+    out.append("")
+    out.append('#include "CaseMap.h"')
+    out.append("")
+    out.append("using namespace utf8;")
+    out.append("")
+
+    emit_table(out, "Lower", *lower_table[:4])
+    emit_table(out, "Upper", *upper_table[:4])
+
+    out.append("static const char Expansions[] =")
+    for i in range(0, len(expansions), 16):
+        out.append('  "' + "".join("\\x%02x" % b for b in expansions[i:i + 16]) + '"')
+    out.append(";")
+    out.append("")
+
+    for name, table in (("Lower", lower_table), ("Upper", upper_table)):
+        out.append("const casemap::Table casemap::%s =" % name)
+        out.append("{")
+        out.append("  0x%X" % table[0])
+        out.append("  , %sIndex" % name)
+        out.append("  , %sBlocks" % name)
+        out.append("  , %sMappings" % name)
+        out.append("  , Expansions")
+        out.append("};")
+        out.append("")
+
+    sys.stdout.write("\n".join(out).rstrip("\n") + "\n")
+
+
+if __name__ == "__main__":
+    main()